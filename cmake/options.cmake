@@ -10,6 +10,7 @@ option(BUILD_SCRIPTDEV                      "Build ScriptDev. (OFF Speedup build
 option(BUILD_PLAYERBOTS                     "Build Playerbots mod"                      OFF)																							
 option(BUILD_AHBOT                          "Build Auction House Bot mod"               OFF)
 option(BUILD_METRICS                        "Build Metrics, generate data for Grafana"  OFF)
+option(USE_IO_URING                         "Use io_uring for network (Linux only)"     OFF)
 option(BUILD_RECASTDEMOMOD                  "Build map/vmap/mmap viewer"                OFF)
 option(BUILD_GIT_ID                         "Build git_id"                              OFF)
 option(BUILD_DOCS                           "Build documentation with doxygen"          OFF)
@@ -39,6 +40,7 @@ message(STATUS
     BUILD_PLAYERBOTS        Build Playerbots mod				 
     BUILD_AHBOT             Build Auction House Bot mod
     BUILD_METRICS           Build Metrics, generate data for Grafana
+    USE_IO_URING            Use io_uring instead of epoll for network (Linux, boost 1.78+, liburing)
     BUILD_RECASTDEMOMOD     Build map/vmap/mmap viewer
     BUILD_GIT_ID            Build git_id
     BUILD_DOCS              Build documentation with doxygen
@@ -61,6 +61,12 @@ else()
   message(STATUS "Build METRICs         : No  (default)")
 endif()
 
+if(USE_IO_URING)
+  message(STATUS "Use io_uring          : Yes")
+else()
+  message(STATUS "Use io_uring          : No  (default)")
+endif()
+
 if(BUILD_DEPRECATED_PLAYERBOT)
   message(STATUS "Build OLD Playerbot   : Yes")
 else()
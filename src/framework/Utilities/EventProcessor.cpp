@@ -21,6 +21,7 @@
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_events = nullptr;
     m_aborting = false;
 }
 
@@ -35,12 +36,11 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    BasicEvent* Event;
+    while ((Event = m_events) && Event->m_execTime <= m_time)
     {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        // remove event from queue
+        Unlink(Event);
 
         if (!Event->to_Abort)
         {
@@ -64,38 +64,30 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (BasicEvent* event = m_events; event;)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent* next = event->m_next;
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        event->to_Abort = true;
+        event->Abort(m_time);
+        if (force || event->IsDeletable())
         {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+            Unlink(event);
+            delete event;
         }
-    }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+        event = next;
+    }
 }
 
 void EventProcessor::KillEvent(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
-    {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
-    }
+    // events being executed are not queued anymore
+    if (!event->m_prevNext)
+        return;
+
+    Unlink(event);
+    delete event;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -104,24 +96,43 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Insert(Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    if (!Event->m_prevNext)
+        return;
 
-        Event->m_execTime = msTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(msTime, Event));
-        break;
-    }
+    Unlink(Event);
+    Event->m_execTime = msTime;
+    Insert(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::Insert(BasicEvent* event)
+{
+    BasicEvent** link = &m_events;
+    while (*link && (*link)->m_execTime <= event->m_execTime)
+        link = &(*link)->m_next;
+
+    event->m_next = *link;
+    if (event->m_next)
+        event->m_next->m_prevNext = &event->m_next;
+    event->m_prevNext = link;
+    *link = event;
+}
+
+void EventProcessor::Unlink(BasicEvent* event)
+{
+    *event->m_prevNext = event->m_next;
+    if (event->m_next)
+        event->m_next->m_prevNext = event->m_prevNext;
+
+    event->m_next = nullptr;
+    event->m_prevNext = nullptr;
+}
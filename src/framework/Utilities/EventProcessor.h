@@ -20,17 +20,18 @@
 #define __EVENTPROCESSOR_H
 
 #include "Platform/Define.h"
-
-#include <map>
+#include "Util/BufferPool.h"
 
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
+        friend class EventProcessor;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_next(nullptr), m_prevNext(nullptr)
         {
         }
 
@@ -38,6 +39,10 @@ class BasicEvent
         {
         };
 
+        // events are created and deleted all the time, their memory comes from the buffer pool thread caches
+        static void* operator new(size_t size) { return BufferPool::Allocate(size); }
+        static void operator delete(void* event, size_t size) { BufferPool::Deallocate(event, size); }
+
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
         // e_time is execution time, p_time is update interval
@@ -53,10 +58,15 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        // link in the time ordered list of the owning processor, m_prevNext is null while not queued
+        BasicEvent* m_next;
+        BasicEvent** m_prevNext;
+};
 
+// Events are linked into a time ordered intrusive list, queuing one does not allocate and killing or
+// rescheduling one does not search for it. Owners rarely hold more than a few events at once.
 class EventProcessor
 {
     public:
@@ -70,13 +80,23 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         void ModifyEventTime(BasicEvent* event, uint64 msTime);
         uint64 CalculateTime(uint64 t_offset) const;
-        EventList& GetEvents() { return m_events; }
-        bool IsEmpty() const { return m_events.empty(); }
+        bool IsEmpty() const { return m_events == nullptr; }
+
+        // visits every queued event in time order, the visitor must not kill or reschedule events
+        template <typename Visitor>
+        void VisitEvents(Visitor&& visitor)
+        {
+            for (BasicEvent* event = m_events; event; event = event->m_next)
+                visitor(event);
+        }
 
     protected:
 
+        void Insert(BasicEvent* event);
+        static void Unlink(BasicEvent* event);
+
         uint64 m_time;
-        EventList m_events;
+        BasicEvent* m_events;                               // earliest event, events of the same time keep their insertion order
         bool m_aborting;
 };
 
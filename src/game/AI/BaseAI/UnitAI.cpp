@@ -886,7 +886,7 @@ void UnitAI::AttackSpecificEnemy(std::function<void(Unit*, Unit*&)> check)
 {
     Unit* chosenEnemy = nullptr;
     ThreatList const& list = m_unit->getThreatManager().getThreatList();
-    for (auto& data : list)
+    for (auto data : list)
     {
         Unit* enemy = data->getTarget();
         check(enemy, chosenEnemy);
@@ -107,7 +107,7 @@ struct priestess_commonAI : public CombatAI
 
                 std::vector<Unit*> units;
                 DoResetThreat();
-                for (auto& data : m_creature->getThreatManager().getThreatList())
+                for (auto data : m_creature->getThreatManager().getThreatList())
                 {
                     if (data->isValid())
                         if (data->getTarget()->IsPlayer())
@@ -933,7 +933,7 @@ AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHou
 
     sAuctionMgr.AddAItem(newItem);
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(pl ? pl->GetGUIDLow() : 0);
 
     newItem->SaveToDB();
     AH->SaveToDB();
@@ -1012,7 +1012,7 @@ void AuctionEntry::AuctionBidWinning(Player* newbidder)
 {
     moneyDeliveryTime = time(nullptr) + HOUR;
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(newbidder ? newbidder->GetGUIDLow() : 0);
     CharacterDatabase.PExecute("UPDATE auction SET itemguid = 0, moneyTime = '" UI64FMTD "', buyguid = '%u', lastbid = '%u' WHERE id = '%u'", (uint64)moneyDeliveryTime, bidder, bid, Id);
     if (newbidder)
         newbidder->SaveInventoryAndGoldToDB();
@@ -1051,7 +1051,7 @@ bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=nullptr*/)
             auction_owner->GetSession()->SendAuctionOwnerNotification(this);
 
         // after this update we should save player's money ...
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(newbidder ? newbidder->GetGUIDLow() : 0);
         CharacterDatabase.PExecute("UPDATE auction SET buyguid = '%u', lastbid = '%u' WHERE id = '%u'", bidder, bid, Id);
         if (newbidder)
             newbidder->SaveInventoryAndGoldToDB();
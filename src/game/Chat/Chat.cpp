@@ -857,6 +857,7 @@ ChatCommand* ChatHandler::getCommandTable()
         { "plimit",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPLimitCommand,        "", nullptr },
         { "resetallraid",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerResetAllRaidCommand,  "", nullptr },
         { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                           "", serverRestartCommandTable },
+        { "savestats",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerSaveStatsCommand,     "", nullptr },
         { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                           "", serverShutdownCommandTable },
         { "set",            SEC_ADMINISTRATOR,  true,  nullptr,                                           "", serverSetCommandTable },
         { nullptr,             0,                  false, nullptr,                                           "", nullptr }
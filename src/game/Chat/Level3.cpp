@@ -5245,9 +5245,10 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
-    for (const auto& itr : plist)
-        itr.second->SetAtLoginFlag(atLogin);
+    sObjectAccessor.ExecuteOnAllPlayers([atLogin](Player* player)
+    {
+        player->SetAtLoginFlag(atLogin);
+    });
 
     return true;
 }
@@ -6405,6 +6406,18 @@ bool ChatHandler::HandlePrintMovement(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleServerSaveStatsCommand(char* /*args*/)
+{
+    CharacterSaveStats last = sWorld.GetLastCharacterSaves();
+    CharacterSaveStats current = sWorld.GetCurrentCharacterSaves();
+
+    PSendSysMessage("Character saves in the last save interval: %u saves, %u statements, %u statements and " UI64FMTD " bytes skipped",
+                    last.saves, last.statements, last.skippedStatements, last.skippedBytes);
+    PSendSysMessage("Character saves in the current save interval: %u saves, %u statements, %u statements and " UI64FMTD " bytes skipped",
+                    current.saves, current.statements, current.skippedStatements, current.skippedBytes);
+    return true;
+}
+
 bool ChatHandler::HandleServerPLimitCommand(char* args)
 {
     if (*args)
@@ -284,45 +284,68 @@ void ThreatContainer::modifyAllThreatPercent(int32 threatPercent)
             itr->addThreatPercent(threatPercent);
     }
 }
+//============================================================
+// Ordering of the references, by priority: for player owners attackable player targets first, then taunt state,
+// melee reach when forced, hostile state and last the threat itself
+
+struct ThreatSortEntry
+{
+    uint64 rank;
+    float threat;
+    HostileReference* ref;
+
+    bool operator<(ThreatSortEntry const& other) const
+    {
+        if (rank != other.rank)
+            return rank > other.rank;
+        return threat > other.threat;                       // reverse sorting
+    }
+};
+
+static uint64 GetThreatSortRank(Unit* owner, HostileReference const* ref, bool force, bool isPlayer)
+{
+    Unit* target = ref->getTarget();
+    uint64 rank = uint64(ref->GetTauntState()) << 2;
+    if (isPlayer)
+    {
+        if (target->IsPlayer())
+            rank |= uint64(1) << 35;
+        if (owner->CanAttack(target))
+            rank |= uint64(1) << 34;
+    }
+    if (force && owner->CanReachWithMeleeAttack(target))
+        rank |= 2;
+    if (ref->GetHostileState() != STATE_SUPPRESSED)
+        rank |= 1;
+    return rank;
+}
+
 //============================================================
 // Check if the list is dirty and sort if necessary
+// The rank of every reference is computed once, so range checks are not repeated for each comparison,
+// and a list still in order, the usual case after a threat change, is only scanned
 
 void ThreatContainer::update(bool force, bool isPlayer)
 {
     if ((iDirty || force || isPlayer) && iThreatList.size() > 1)
     {
-        iThreatList.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
+        Unit* owner = iThreatList.front()->getSource()->getOwner();
+
+        std::vector<ThreatSortEntry> entries;
+        entries.reserve(iThreatList.size());
+        for (HostileReference* ref : iThreatList)
+            entries.push_back({ GetThreatSortRank(owner, ref, force, isPlayer), ref->getThreat(), ref });
+
+        if (!std::is_sorted(entries.begin(), entries.end()))
         {
-            Unit* owner = lhs->getSource()->getOwner();
-            if (isPlayer)
-            {
-                Unit* left = lhs->getTarget();
-                Unit* right = rhs->getTarget();
-                if (left->IsPlayer() && !right->IsPlayer())
-                    return true;
-                if (!left->IsPlayer() && right->IsPlayer())
-                    return false;
-                bool attackLeft = owner->CanAttack(left);
-                bool attackRight = owner->CanAttack(right);
-                if (attackLeft && !attackRight)
-                    return true;
-                if (!attackLeft && attackRight)
-                    return false;
-            }
-            if (lhs->GetTauntState() != rhs->GetTauntState())
-                return lhs->GetTauntState() > rhs->GetTauntState();
-            if (force)
-            {
-                bool first = owner->CanReachWithMeleeAttack(lhs->getTarget());
-                bool second = owner->CanReachWithMeleeAttack(rhs->getTarget());
-                if (first != second)
-                    return first > second;
-            }
-            if (lhs->GetHostileState() != rhs->GetHostileState())
-                return lhs->GetHostileState() > rhs->GetHostileState();
-            return lhs->getThreat() > rhs->getThreat(); // reverse sorting
-        });
+            std::stable_sort(entries.begin(), entries.end());
+
+            iThreatList.clear();
+            for (ThreatSortEntry const& entry : entries)
+                iThreatList.push_back(entry.ref);
+        }
     }
+    iThreatList.Compact();
     iDirty = false;
 }
 
@@ -339,9 +362,6 @@ HostileReference* ThreatContainer::selectNextVictim(Unit* attacker, HostileRefer
     if (suppressRanged && currentVictim)
         currentVictimInMelee = attacker->CanReachWithMeleeAttack(currentVictim->getTarget());
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
     for (ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
     {
         currentRef = (*iter);
@@ -543,6 +563,7 @@ void ThreatManager::modifyAllThreatPercent(int32 threatPercent)
 void ThreatManager::UpdateContainers()
 {
     iThreatContainer.update(getOwner()->IsIgnoringRangedTargets(), getOwner()->IsPlayer());
+    iThreatOfflineContainer.compact();
 }
 
 Unit* ThreatManager::getHostileTarget()
@@ -572,10 +593,10 @@ float ThreatManager::getThreat(Unit* victim, bool alsoSearchOfflineList)
 float ThreatManager::GetHighestThreat()
 {
     float value = 0.f;
-    for (auto& ref : iThreatContainer.getThreatList())
+    for (auto ref : iThreatContainer.getThreatList())
         if (ref->getThreat() > value)
             value = ref->getThreat();
-    for (auto& ref : iThreatOfflineContainer.getThreatList())
+    for (auto ref : iThreatOfflineContainer.getThreatList())
         if (ref->getThreat() > value)
             value = ref->getThreat();
     return value;
@@ -599,7 +620,7 @@ void ThreatManager::TauntUpdate()
     for (auto tauntAura : tauntAuras)
         tauntStates[tauntAura->GetCasterGuid()] = TauntState(state++);
 
-    for (auto& ref : iThreatContainer.getThreatList())
+    for (auto ref : iThreatContainer.getThreatList())
     {
         if (ref->GetTauntState() == STATE_FIXATED)
             continue;
@@ -620,7 +641,7 @@ void ThreatManager::FixateTarget(Unit* victim)
     if (fixateRef)
         fixateRef->SetTauntState(STATE_FIXATED);
 
-    for (auto& ref : iThreatContainer.getThreatList())
+    for (auto ref : iThreatContainer.getThreatList())
         if (ref != fixateRef && ref->GetTauntState() == STATE_FIXATED)
             ref->SetTauntState(STATE_NONE);
 
@@ -735,10 +756,10 @@ void ThreatManager::ClearSuppressed(HostileReference* except)
 void ThreatManager::DeleteOutOfRangeReferences()
 {
     std::vector<HostileReference*> m_refs;
-    for (auto& ref : iThreatContainer.getThreatList())
+    for (auto ref : iThreatContainer.getThreatList())
         if (ref->isValid() && ref->getTarget()->GetDistance(getOwner(), true, DIST_CALC_COMBAT_REACH) > 60.f)
             m_refs.push_back(ref);
-    for (auto& ref : iThreatOfflineContainer.getThreatList())
+    for (auto ref : iThreatOfflineContainer.getThreatList())
         if (ref->isValid() && ref->getTarget()->GetDistance(getOwner(), true, DIST_CALC_COMBAT_REACH) > 60.f)
             m_refs.push_back(ref);
     for (auto& ref : m_refs)
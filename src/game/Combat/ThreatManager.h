@@ -24,8 +24,8 @@
 #include "Utilities/LinkedReference/Reference.h"
 #include "Entities/UnitEvents.h"
 #include "Util/Timer.h"
+#include "Util/StableVector.h"
 #include "Entities/ObjectGuid.h"
-#include <list>
 
 //==============================================================
 
@@ -147,7 +147,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// references may be removed while the list is iterated, holes are dropped when the container is sorted
+typedef StableVector<HostileReference*> ThreatList;
 
 class ThreatContainer
 {
@@ -181,6 +182,8 @@ class ThreatContainer
         void clearReferences();
         // Sort the list if necessary
         void update(bool force, bool isPlayer);
+        // drop removed references, nothing may iterate the list
+        void compact() { iThreatList.Compact(); }
 
         ThreatList iThreatList;
     private:
@@ -616,7 +616,7 @@ void GameObject::Update(const uint32 diff)
             switch (GetGoType())
             {
                 case GAMEOBJECT_TYPE_TRAP:
-                    if (m_events.GetEvents().size() > 0)
+                    if (!m_events.IsEmpty())
                     {
                         preventDespawn = true;
                         break;
@@ -1208,12 +1208,11 @@ void Item::RemoveFromClientUpdateList()
         pl->GetMap()->RemoveUpdateObject(this);
 }
 
-void Item::BuildUpdateData(UpdateDataMapType& update_players)
+void Item::BuildUpdateDataForShard(UpdateDataMapType& update_players, uint32 shard, uint32 shardCount) const
 {
     if (Player* pl = GetOwner())
-        BuildUpdateDataForPlayer(pl, update_players);
-
-    ClearUpdateMask(false);
+        if (IsInUpdateShard(pl, shard, shardCount))
+            BuildUpdateDataForPlayer(pl, update_players);
 }
 
 void Item::UpdateVisibility(UpdateDataMapType& /*update_players*/)
@@ -384,7 +384,7 @@ class Item : public Object
 
         void AddToClientUpdateList() override;
         void RemoveFromClientUpdateList() override;
-        void BuildUpdateData(UpdateDataMapType& update_players) override;
+        void BuildUpdateDataForShard(UpdateDataMapType& update_players, uint32 shard, uint32 shardCount) const override;
         void UpdateVisibility(UpdateDataMapType& update_players) override;
 
         bool IsUsedInSpell() const { return m_usedInSpell; }
@@ -214,14 +214,87 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData& data, Player* target) c
     data.AddUpdateBlock(buf);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, UpdateValuesCache* cache) const
 {
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
-    _SetUpdateBits(updateMask, target);
-    if (updateMask.HasData())
+    uint16 visibleFlag = _SetUpdateBits(updateMask, target);
+    if (!updateMask.HasData())
+        return;
+
+    uint32 key;
+    if (!cache || !GetSharedValuesUpdateKey(updateMask, target, visibleFlag, key))
+    {
         BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+        return;
+    }
+
+    if (ByteBuffer const* block = cache->Find(key))
+    {
+        data.AddUpdateBlock(*block);
+        ++cache->m_hits;
+        return;
+    }
+
+    ByteBuffer buf(500);
+
+    buf << uint8(UPDATETYPE_VALUES);
+    buf << GetPackGUID();
+
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    data.AddUpdateBlock(buf);
+
+    cache->m_blocks.emplace_back(key, std::move(buf));
+    ++cache->m_misses;
+}
+
+// Values blocks only depend on the visibility flags of the observer, except for the fields adjusted per observer
+// in BuildValuesUpdate. A block with any of those adjustments applied is never shared
+bool Object::GetSharedValuesUpdateKey(UpdateMask const& updateMask, Player const* target, uint16 visibleFlag, uint32& key) const
+{
+    if (target == this)
+        return false;
+
+    key = visibleFlag;
+
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+        {
+            Unit const* unit = static_cast<Unit const*>(this);
+
+            if (updateMask.GetBit(UNIT_DYNAMIC_FLAGS))
+                return false;
+
+            if (GetTypeId() == TYPEID_UNIT && updateMask.GetBit(UNIT_NPC_FLAGS))
+                return false;
+
+            if (GetTypeId() == TYPEID_PLAYER && updateMask.GetBit(UNIT_FIELD_FACTIONTEMPLATE))
+                return false;
+
+            // the aura state is added to every block and the per caster state only kept for its caster
+            if (unit->HasAuraState(AURA_STATE_CONFLAGRATE))
+                return false;
+
+            if (updateMask.GetBit(UNIT_FIELD_FLAGS) && target->IsGameMaster())
+                return false;
+
+            if (updateMask.GetBit(UNIT_FIELD_HEALTH) || updateMask.GetBit(UNIT_FIELD_MAXHEALTH))
+                if (!unit->IsFogOfWarVisibleHealth(target) && !target->CanSeeSpecialInfoOf(unit))
+                    return false;
+
+            return true;
+        }
+        case TYPEID_GAMEOBJECT:
+            // GAMEOBJECT_DYNAMIC is always sent and depends on the quests of the observer
+            return static_cast<GameObject const*>(this)->IsDynTransport();
+        case TYPEID_CORPSE:
+            return !updateMask.GetBit(CORPSE_FIELD_BYTES_1);
+        default:
+            return true;
+    }
 }
 
 void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const
@@ -988,7 +1061,7 @@ void Object::MarkUpdateFieldsWithFlagForUpdate(UpdateMask& updateMask, uint16 fl
     }
 }
 
-void Object::_SetUpdateBits(UpdateMask& updateMask, Player* target) const
+uint16 Object::_SetUpdateBits(UpdateMask& updateMask, Player* target) const
 {
     uint16 const* flags = nullptr;
     uint16 visibleFlag = GetUpdateFieldFlagsForTarget(target, flags);
@@ -997,6 +1070,8 @@ void Object::_SetUpdateBits(UpdateMask& updateMask, Player* target) const
     for (uint16 index = 0; index < m_valuesCount; ++index)
         if (m_changedValues[index] && (flags[index] & visibleFlag))
             updateMask.SetBit(index);
+
+    return visibleFlag;
 }
 
 void Object::_SetCreateBits(UpdateMask& updateMask, Player* target) const
@@ -1249,7 +1324,19 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
+void Object::BuildUpdateData(UpdateDataMapType& update_players)
+{
+    PrepareUpdateData();
+    BuildUpdateDataForShard(update_players, 0, 1);
+    FinishUpdateData();
+}
+
+uint32 Object::GetUpdateShard(Player const* pl, uint32 shardCount)
+{
+    return pl->GetGUIDLow() % shardCount;
+}
+
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateValuesCache* cache) const
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1260,7 +1347,7 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(iter->second, iter->first, cache);
 }
 
 void Object::BuildCreateDataForPlayer(Player* pl, UpdateDataMapType& update_players, bool auras) const
@@ -2751,21 +2838,32 @@ struct WorldObjectCreateAccumulator
     template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
 };
 
-void WorldObject::BuildUpdateData(UpdateDataMapType& update_players)
+void WorldObject::PrepareUpdateData()
 {
     if (ItsNewObject())
         GetMap()->AddCameraToWorld(this);
+}
 
-    if (IsPlayer())
+void WorldObject::BuildUpdateDataForShard(UpdateDataMapType& update_players, uint32 shard, uint32 shardCount) const
+{
+    if (IsPlayer() && IsInUpdateShard((Player const*)this, shard, shardCount))
         BuildUpdateDataForPlayer((Player*)this, update_players);
 
+    // observers seeing the same fields share one values block
+    UpdateValuesCache cache;
     for (auto& iter : m_clientGUIDsIAmAt)
     {
         if (Player* player = GetMap()->GetPlayer(iter))
-            if (player != this && player->HasAtClient(this))
-                BuildUpdateDataForPlayer(player, update_players);
+            if (player != this && IsInUpdateShard(player, shard, shardCount) && player->HasAtClient(this))
+                BuildUpdateDataForPlayer(player, update_players, &cache);
     }
 
+    if (cache.m_hits || cache.m_misses)
+        GetMap()->AddValuesCacheStats(cache.m_hits, cache.m_misses);
+}
+
+void WorldObject::FinishUpdateData()
+{
     ClearUpdateMask(false);
 
     if (ItsNewObject())
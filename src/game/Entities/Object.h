@@ -419,11 +419,17 @@ class Object
         virtual void AddToClientUpdateList();
         virtual void RemoveFromClientUpdateList();
         virtual void UpdateVisibility(UpdateDataMapType& update_players) = 0;
-        virtual void BuildUpdateData(UpdateDataMapType& update_players) = 0;
+        void BuildUpdateData(UpdateDataMapType& update_players);
+        // BuildUpdateData steps, only BuildUpdateDataForShard is safe to run concurrently (for different shards)
+        virtual void PrepareUpdateData() {}
+        virtual void BuildUpdateDataForShard(UpdateDataMapType& update_players, uint32 shard, uint32 shardCount) const = 0;
+        virtual void FinishUpdateData() { ClearUpdateMask(false); }
+        static uint32 GetUpdateShard(Player const* pl, uint32 shardCount);
+        static bool IsInUpdateShard(Player const* pl, uint32 shard, uint32 shardCount) { return GetUpdateShard(pl, shardCount) == shard; }
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
-        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, UpdateValuesCache* cache = nullptr) const;
         void BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const;
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updateMask, Player* target) const;
         void BuildForcedValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const;
@@ -649,12 +655,13 @@ class Object
         void _Create(uint32 dbGuid, uint32 guidlow, uint32 entry, HighGuid guidhigh);
 
         uint16 GetUpdateFieldFlagsForTarget(Player const* target, uint16 const*& flags) const;
-        void _SetUpdateBits(UpdateMask& updateMask, Player* target) const;
+        uint16 _SetUpdateBits(UpdateMask& updateMask, Player* target) const;
+        bool GetSharedValuesUpdateKey(UpdateMask const& updateMask, Player const* target, uint16 visibleFlag, uint32& key) const;
         void _SetCreateBits(UpdateMask& updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateValuesCache* cache = nullptr) const;
 
         uint16 m_objectType;
 
@@ -1183,7 +1190,9 @@ class WorldObject : public Object
 
         void AddToClientUpdateList() override;
         void RemoveFromClientUpdateList() override;
-        void BuildUpdateData(UpdateDataMapType&) override;
+        void PrepareUpdateData() override;
+        void BuildUpdateDataForShard(UpdateDataMapType& update_players, uint32 shard, uint32 shardCount) const override;
+        void FinishUpdateData() override;
         void UpdateVisibility(UpdateDataMapType& update_players) override;
         
         static Creature* SummonCreature(TempSpawnSettings settings, Map* map, uint32 phaseMask);
@@ -221,7 +221,7 @@ bool Pet::LoadPetFromDB(Player* owner, Position const& spawnPos, uint32 petentry
         owner->SetTemporaryUnsummonedPetNumber(pet_number);
 
         // change pet slot directly in database
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(owner->GetGUIDLow());
         static SqlStatementID ChangePetSlot_ID;
         SqlStatement ChangePetSlot = CharacterDatabase.CreateStatement(ChangePetSlot_ID, "UPDATE character_pet SET slot = ? WHERE id = ? ");
         ChangePetSlot.PExecute(uint32(PET_SAVE_AS_CURRENT), pet_number);
@@ -450,13 +450,14 @@ void Pet::SavePetToDB(PetSaveMode mode, Player* owner)
                 RemoveAllAuras();
         }
 
-        // save pet's data as one single transaction
-        CharacterDatabase.BeginTransaction();
+        uint32 ownerLow = GetOwnerGuid().GetCounter();
+
+        // save pet's data as one single transaction, ordered with the saves of its owner
+        CharacterDatabase.BeginTransaction(ownerLow);
         _SaveSpells();
         _SaveSpellCooldowns();
         _SaveAuras();
 
-        uint32 ownerLow = GetOwnerGuid().GetCounter();
         // remove current data
         static SqlStatementID delPet ;
         static SqlStatementID insPet ;
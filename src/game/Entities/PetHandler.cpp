@@ -654,7 +654,7 @@ void WorldSession::HandlePetRename(WorldPacket& recv_data)
         }
     }
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(_player->GetGUIDLow());
     if (isdeclined)
     {
         for (auto& i : declinedname.name)
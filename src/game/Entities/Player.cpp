@@ -4188,15 +4188,9 @@ void Player::_LoadSpellCooldowns(std::unique_ptr<QueryResult> queryResult)
     }
 }
 
-void Player::_SaveSpellCooldowns()
+void Player::_SaveSpellCooldowns(bool full, CharacterSaveStats& stats)
 {
-    static SqlStatementID deleteSpellCooldown;
-
-    // delete all old cooldown
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    static SqlStatementID insertSpellCooldown;
+    std::map<uint32, SavedCooldownRow> cooldowns;
 
     for (auto& cdItr : m_cooldownMap)
     {
@@ -4207,19 +4201,76 @@ void Player::_SaveSpellCooldowns()
             TimePoint cTime = TimePoint::min();
             cdData->GetSpellCDExpireTime(sTime);
             cdData->GetCatCDExpireTime(cTime);
-            uint64 spellExpireTime = uint64(Clock::to_time_t(sTime));
-            uint64 catExpireTime = uint64(Clock::to_time_t(cTime));
 
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt32(cdData->GetSpellId());
-            stmt.addUInt64(spellExpireTime);
-            stmt.addUInt32(cdData->GetCategory());
-            stmt.addUInt64(catExpireTime);
-            stmt.addUInt32(cdData->GetItemId());
-            stmt.Execute();
+            SavedCooldownRow& row = cooldowns[cdData->GetSpellId()];
+            row.spellExpireTime = uint64(Clock::to_time_t(sTime));
+            row.category = cdData->GetCategory();
+            row.categoryExpireTime = uint64(Clock::to_time_t(cTime));
+            row.itemId = cdData->GetItemId();
+        }
+    }
+
+    uint32 statements = 0;
+    if (full)
+    {
+        static SqlStatementID deleteSpellCooldown;
+
+        // delete all old cooldown
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+        ++statements;
+    }
+    else
+    {
+        static SqlStatementID deleteExpiredCooldown;
+
+        // delete only the expired ones
+        for (auto const& saved : m_savedCooldowns)
+        {
+            if (cooldowns.find(saved.first) != cooldowns.end())
+                continue;
+
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteExpiredCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ? AND SpellId = ?");
+            stmt.PExecute(GetGUIDLow(), saved.first);
+            ++statements;
+        }
+    }
+
+    static SqlStatementID replaceSpellCooldown;
+
+    // write new and changed rows only
+    uint32 unchanged = 0;
+    for (auto const& cooldown : cooldowns)
+    {
+        SavedCooldownRow const& row = cooldown.second;
+        if (!full)
+        {
+            auto saved = m_savedCooldowns.find(cooldown.first);
+            if (saved != m_savedCooldowns.end() && saved->second == row)
+            {
+                ++unchanged;
+                continue;
+            }
         }
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(replaceSpellCooldown, "REPLACE INTO character_spell_cooldown (guid, SpellId, SpellExpireTime, Category, CategoryExpireTime, ItemId) VALUES( ?, ?, ?, ?, ?, ?)");
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(cooldown.first);
+        stmt.addUInt64(row.spellExpireTime);
+        stmt.addUInt32(row.category);
+        stmt.addUInt64(row.categoryExpireTime);
+        stmt.addUInt32(row.itemId);
+        stmt.Execute();
+        ++statements;
     }
+
+    // compared to deleting every row and inserting them one by one, 32 bytes of parameters per row
+    uint32 fullStatements = 1 + cooldowns.size();
+    if (statements < fullStatements)
+        stats.skippedStatements += fullStatements - statements;
+    stats.skippedBytes += unchanged * 32;
+
+    m_savedCooldowns = std::move(cooldowns);
 }
 
 uint32 Player::resetTalentsCost() const
@@ -4377,7 +4428,7 @@ void Player::SendItemRetrievalMail(uint32 itemEntry, uint32 count)
 {
     MailSender sender(MAIL_CREATURE, 34337u /* The Postmaster */);
     MailDraft draft("Recovered Item", "We recovered a lost item in the twisting nether and noted that it was yours.$B$BPlease find said object enclosed."); // This is the text used in Cata, it probably wasn't changed.
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(GetGUIDLow());
 
     if (Item* item = Item::CreateItem(itemEntry, count, nullptr))
     {
@@ -4738,7 +4789,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             auto  resultFriend = CharacterDatabase.PQuery("SELECT DISTINCT guid FROM character_social WHERE friend = '%u'", lowguid);
 
             // NOW we can finally clear other DB data related to character
-            CharacterDatabase.BeginTransaction();
+            CharacterDatabase.BeginTransaction(lowguid);
             if (resultPets)
             {
                 do
@@ -18216,15 +18267,19 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
+    // rows written by the last save are only rewritten when they changed, the first save, the logout save
+    // and any save not knowing the previous one to be committed write everything
+    CharacterSaveStats saveStats;
+    bool full = !m_lastSaveResult || m_lastSaveResult->load(std::memory_order_acquire) != SQL_TRANSACTION_COMMITTED || m_session->isLogingOut();
 
-    static SqlStatementID delChar ;
-    static SqlStatementID insChar ;
+    // saves of different characters may be written in parallel
+    CharacterDatabase.BeginTransaction(GetGUIDLow());
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    static SqlStatementID insChar ;
 
-    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
+    // replaces the row in place instead of deleting and inserting it again
+    ++saveStats.skippedStatements;
+    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "REPLACE INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
                               "map, dungeon_difficulty, position_x, position_y, position_z, orientation, "
                               "taximask, online, cinematic, "
                               "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
@@ -18391,9 +18446,9 @@ void Player::SaveToDB()
     _SaveWeeklyQuestStatus();
     _SaveMonthlyQuestStatus();
     _SaveSpells();
-    _SaveSpellCooldowns();
+    _SaveSpellCooldowns(full, saveStats);
     _SaveActions();
-    _SaveAuras();
+    _SaveAuras(full, saveStats);
     _SaveSkills();
     _SaveNewInstanceIdTimer();
     m_achievementMgr.SaveToDB();
@@ -18403,12 +18458,16 @@ void Player::SaveToDB()
     _SaveGlyphs();
     _SaveTalents();
 
-    CharacterDatabase.CommitTransaction();
+    saveStats.statements += CharacterDatabase.GetTransactionSize();
+    CharacterDatabase.CommitTransaction(&m_lastSaveResult);
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
-        _SaveStats();
+        _SaveStats(saveStats);
+
+    saveStats.saves = 1;
+    sWorld.AddCharacterSave(saveStats);
 
     // save pet (hunter pet level and experience and all type pets health/mana except priest pet).
     if (Pet* pet = GetPet())
@@ -18486,38 +18545,24 @@ void Player::_SaveActions()
     }
 }
 
-void Player::_SaveAuras()
+void Player::_SaveAuras(bool full, CharacterSaveStats& stats)
 {
-    static SqlStatementID deleteAuras ;
-    static SqlStatementID insertAuras ;
+    std::map<SavedAuraKey, SavedAuraRow> auras;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
-    SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
-
-    if (auraHolders.empty())
-        return;
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
-            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
-    for (const auto& auraHolder : auraHolders)
+    for (const auto& auraHolder : GetSpellAuraHolderMap())
     {
         SpellAuraHolder* holder = auraHolder.second;
         // skip all holders from spells that are passive or channeled
         // save singleTarget auras if self cast.
         if (holder->IsSaveToDbHolder())
         {
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
-            uint32 effIndexMask = 0;
+            SavedAuraRow row;
+            row.effIndexMask = 0;
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                damage[i] = 0;
-                periodicTime[i] = 0;
+                row.damage[i] = 0;
+                row.periodicTime[i] = 0;
 
                 if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
                 {
@@ -18525,34 +18570,99 @@ void Player::_SaveAuras()
                     if (!aur->IsSaveToDbAura())
                         continue;
 
-                    damage[i] = aur->GetModifier()->m_amount;
-                    periodicTime[i] = aur->GetModifier()->periodictime;
-                    effIndexMask |= (1 << i);
+                    row.damage[i] = aur->GetModifier()->m_amount;
+                    row.periodicTime[i] = aur->GetModifier()->periodictime;
+                    row.effIndexMask |= (1 << i);
                 }
             }
 
-            if (!effIndexMask)
+            if (!row.effIndexMask)
                 continue;
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            row.stackAmount = holder->GetStackAmount();
+            row.charges = holder->GetAuraCharges();
+            row.maxDuration = holder->GetAuraMaxDuration();
+            row.duration = holder->GetAuraDuration();
+            auras[SavedAuraKey(holder->GetCasterGuid().GetRawValue(), holder->GetCastItemGuid().GetCounter(), holder->GetId())] = row;
+        }
+    }
 
-            for (int i : damage)
-                stmt.addInt32(i);
+    uint32 statements = 0;
+    if (full)
+    {
+        static SqlStatementID deleteAuras ;
 
-            for (unsigned int i : periodicTime)
-                stmt.addUInt32(i);
+        SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+        stmt.PExecute(GetGUIDLow());
+        ++statements;
+    }
+    else
+    {
+        static SqlStatementID deleteRemovedAura;
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
+        // delete only the removed ones
+        for (auto const& saved : m_savedAuras)
+        {
+            if (auras.find(saved.first) != auras.end())
+                continue;
+
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteRemovedAura, "DELETE FROM character_aura WHERE guid = ? AND caster_guid = ? AND item_guid = ? AND spell = ?");
+            stmt.addUInt32(GetGUIDLow());
+            stmt.addUInt64(std::get<0>(saved.first));
+            stmt.addUInt32(std::get<1>(saved.first));
+            stmt.addUInt32(std::get<2>(saved.first));
             stmt.Execute();
+            ++statements;
         }
     }
+
+    static SqlStatementID replaceAura;
+
+    // write new and changed rows only
+    uint32 unchanged = 0;
+    for (auto const& aura : auras)
+    {
+        SavedAuraRow const& row = aura.second;
+        if (!full)
+        {
+            auto saved = m_savedAuras.find(aura.first);
+            if (saved != m_savedAuras.end() && saved->second == row)
+            {
+                ++unchanged;
+                continue;
+            }
+        }
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(replaceAura, "REPLACE INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+                            "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
+                            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt64(std::get<0>(aura.first));
+        stmt.addUInt32(std::get<1>(aura.first));
+        stmt.addUInt32(std::get<2>(aura.first));
+        stmt.addUInt32(row.stackAmount);
+        stmt.addUInt8(row.charges);
+
+        for (int32 damage : row.damage)
+            stmt.addInt32(damage);
+
+        for (uint32 periodicTime : row.periodicTime)
+            stmt.addUInt32(periodicTime);
+
+        stmt.addInt32(row.maxDuration);
+        stmt.addInt32(row.duration);
+        stmt.addUInt32(row.effIndexMask);
+        stmt.Execute();
+        ++statements;
+    }
+
+    // compared to deleting every row and inserting them one by one, 61 bytes of parameters per row
+    uint32 fullStatements = 1 + auras.size();
+    if (statements < fullStatements)
+        stats.skippedStatements += fullStatements - statements;
+    stats.skippedBytes += unchanged * 61;
+
+    m_savedAuras = std::move(auras);
 }
 
 void Player::_SaveGlyphs()
@@ -18986,19 +19096,18 @@ void Player::_SaveTalents()
 
 // save player stats -- only for external usage
 // real stats will be recalculated on player login
-void Player::_SaveStats()
+void Player::_SaveStats(CharacterSaveStats& stats)
 {
     // check if stat saving is enabled and if char level is high enough
     if (!sWorld.getConfig(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE) || GetLevel() < sWorld.getConfig(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE))
         return;
 
-    static SqlStatementID delStats ;
     static SqlStatementID insertStats ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delStats, "DELETE FROM character_stats WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    ++stats.statements;
+    ++stats.skippedStatements;
 
-    stmt = CharacterDatabase.CreateStatement(insertStats, "INSERT INTO character_stats (guid, maxhealth, maxpower1, maxpower2, maxpower3, maxpower4, maxpower5, maxpower6, maxpower7, "
+    SqlStatement stmt = CharacterDatabase.CreateStatement(insertStats, "REPLACE INTO character_stats (guid, maxhealth, maxpower1, maxpower2, maxpower3, maxpower4, maxpower5, maxpower6, maxpower7, "
             "strength, agility, stamina, intellect, spirit, armor, resHoly, resFire, resNature, resFrost, resShadow, resArcane, "
             "blockPct, dodgePct, parryPct, critPct, rangedCritPct, spellCritPct, attackPower, rangedAttackPower, spellPower) "
             "VALUES ( ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
@@ -22128,7 +22237,7 @@ void Player::AutoUnequipOffhandIfNeed(uint8 bag)
     else
     {
         MoveItemFromInventory(INVENTORY_SLOT_BAG_0, EQUIPMENT_SLOT_OFFHAND, true);
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(GetGUIDLow());
         offItem->DeleteFromInventoryDB();                   // deletes item from character's inventory
         offItem->SaveToDB();                                // recursive and not have transaction guard into self, item not in inventory and can be save standalone
         CharacterDatabase.CommitTransaction();
@@ -45,6 +45,7 @@
 #include "BattleGround/BattleGroundDefines.h"
 
 #include <functional>
+#include <tuple>
 #include <vector>
 
 struct Mail;
@@ -72,6 +73,7 @@ class PlayerbotMgr;
 #endif
 
 struct AreaTrigger;
+struct CharacterSaveStats;
 
 typedef std::deque<Mail*> PlayerMails;
 
@@ -1010,6 +1012,32 @@ struct BGData
     bool m_needSave;                                        ///< true, if saved to DB fields modified after prev. save (marked as "saved" above)
 };
 
+// rows written by the previous save, the next one only writes the rows which differ from them
+typedef std::tuple<uint64, uint32, uint32> SavedAuraKey;   // caster guid, cast item guid, spell
+
+struct SavedAuraRow
+{
+    uint32 stackAmount;
+    uint8 charges;
+    int32 damage[MAX_EFFECT_INDEX];
+    uint32 periodicTime[MAX_EFFECT_INDEX];
+    int32 maxDuration;
+    int32 duration;
+    uint32 effIndexMask;
+
+    bool operator==(SavedAuraRow const&) const = default;
+};
+
+struct SavedCooldownRow
+{
+    uint64 spellExpireTime;
+    uint32 category;
+    uint64 categoryExpireTime;
+    uint32 itemId;
+
+    bool operator==(SavedCooldownRow const&) const = default;
+};
+
 struct TradeStatusInfo
 {
     TradeStatusInfo() : Status(TRADE_STATUS_BUSY), TraderGuid(), Result(EQUIP_ERR_OK),
@@ -2577,7 +2605,7 @@ class Player : public Unit
         void SendClearCooldown(uint32 spell_id, Unit* target) const;
         void RemoveArenaSpellCooldowns();
         void _LoadSpellCooldowns(std::unique_ptr<QueryResult> queryResult);
-        void _SaveSpellCooldowns();
+        void _SaveSpellCooldowns(bool full, CharacterSaveStats& stats);
         void SetLastPotionId(uint32 itemId) { m_lastPotionId = itemId; }
         void SetCooldownEventOnLeaveCombatSpellId(uint32 spellId) { m_triggerCoooldownOnLeaveCombatSpellId = spellId; }
         uint32 GetLastPotionId() const { return m_lastPotionId; }
@@ -2705,7 +2733,7 @@ class Player : public Unit
         /*********************************************************/
 
         void _SaveActions();
-        void _SaveAuras();
+        void _SaveAuras(bool full, CharacterSaveStats& stats);
         void _SaveInventory();
         void _SaveMail();
         void _SaveQuestStatus();
@@ -2718,7 +2746,7 @@ class Player : public Unit
         void _SaveBGData();
         void _SaveGlyphs();
         void _SaveTalents();
-        void _SaveStats();
+        void _SaveStats(CharacterSaveStats& stats);
 
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -2754,6 +2782,9 @@ class Player : public Unit
 
         Team m_team;
         uint32 m_nextSave;
+        SqlTransactionResult m_lastSaveResult;              // the saved rows below match the database once it is committed
+        std::map<SavedAuraKey, SavedAuraRow> m_savedAuras;
+        std::map<uint32, SavedCooldownRow> m_savedCooldowns;
         time_t m_speakTime;
         uint32 m_speakCount;
         Difficulty m_dungeonDifficulty;
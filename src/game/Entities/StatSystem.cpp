@@ -178,7 +178,7 @@ void Player::UpdateArmor()
     float dynamic = (GetStat(STAT_AGILITY) * 2.0f);
 
     // Add dynamic flat mods
-    for (auto& i : GetAurasByType(SPELL_AURA_MOD_RESISTANCE_OF_STAT_PERCENT))
+    for (auto i : GetAurasByType(SPELL_AURA_MOD_RESISTANCE_OF_STAT_PERCENT))
     {
         if (Modifier* mod = i->GetModifier())
         {
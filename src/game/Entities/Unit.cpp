@@ -313,6 +313,7 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procHoldersGeneration = sSpellMgr.GetSpellProcEventGeneration();
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -2469,9 +2470,7 @@ void Unit::DealMeleeDamage(CalcDamageInfo* calcDamageInfo, bool durabilityLoss)
 
 void Unit::HandleEmoteCommand(uint32 emote_id)
 {
-    WorldPacket data(SMSG_EMOTE, 4 + 8);
-    data << uint32(emote_id);
-    data << GetObjectGuid();
+    WorldPacket data = WorldPacket::Build(SMSG_EMOTE, uint32(emote_id), GetObjectGuid());
     SendMessageToSet(data, true);
 }
 
@@ -3125,9 +3124,7 @@ float Unit::CalculateLevelPenalty(SpellEntry const* spellProto) const
 
 void Unit::SendMeleeAttackStart(const Unit& victim) const
 {
-    WorldPacket data(SMSG_ATTACKSTART, 8 + 8);
-    data << GetObjectGuid();
-    data << victim.GetObjectGuid();
+    WorldPacket data = WorldPacket::Build(SMSG_ATTACKSTART, GetObjectGuid(), victim.GetObjectGuid());
 
     SendMessageToSet(data, true);
     DETAIL_FILTER_LOG(LOG_FILTER_COMBAT, "WORLD: Sent SMSG_ATTACKSTART");
@@ -5550,6 +5547,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddProcHolder(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -6202,6 +6200,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            RemoveProcHolder(holder);
             m_hasPeriodicAura = HasPeriodicAura();
             if (!m_hasPeriodicAura)
                 SetNextUpdateTime(0);
@@ -6270,7 +6269,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     // remove from list before mods removing (prevent cyclic calls, mods added before including to aura list - use reverse order)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
-        m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        RemoveModAura(Aur, Aur->GetModifier()->m_auraname);
     }
 
     // Set remove mode
@@ -7014,10 +7013,7 @@ void Unit::CasterHitTargetWithSpell(Unit* realCaster, Unit* target, SpellEntry c
 
 void Unit::SendAIReaction(AiReaction reactionType)
 {
-    WorldPacket data(SMSG_AI_REACTION, 12);
-
-    data << GetObjectGuid();
-    data << uint32(reactionType);
+    WorldPacket data = WorldPacket::Build(SMSG_AI_REACTION, GetObjectGuid(), uint32(reactionType));
 
     SendMessageToSet(data, true);
 
@@ -9521,14 +9517,10 @@ void Unit::UpdateVisibilityAndView()
             Aura* aura = (*it);
             Unit* owner = aura->GetCaster();
 
+            ++it;
+
             if (!owner || !IsVisibleForOrDetect(owner, this, false))
-            {
-                alist.erase(it);
                 RemoveAura(aura);
-                it = alist.begin();
-            }
-            else
-                ++it;
         }
     }
 
@@ -10713,11 +10705,10 @@ void Unit::ApplyMaxPowerMod(Powers power, uint32 val, bool apply)
 
 void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
 {
-    AuraList& tAuraProcTriggerDamage = m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE];
     if (apply)
-        tAuraProcTriggerDamage.push_back(aura);
+        m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE].push_back(aura);
     else
-        tAuraProcTriggerDamage.remove(aura);
+        RemoveModAura(aura, SPELL_AURA_PROC_TRIGGER_DAMAGE);
 }
 
 uint32 Unit::GetCreatePowers(Powers power) const
@@ -12361,6 +12352,54 @@ void Unit::CleanupDeletedAuras()
     for (AuraList::const_iterator itr = m_deletedAuras.begin(); itr != m_deletedAuras.end(); ++itr)
         delete *itr;
     m_deletedAuras.clear();
+
+    // nothing iterates the aura lists here, drop the entries removed since the last update
+    for (AuraType type : m_modAurasToCompact)
+        m_modAuras[type].Compact();
+    m_modAurasToCompact.clear();
+}
+
+void Unit::AddProcHolder(SpellAuraHolder* holder)
+{
+    uint32 procFlags = sSpellMgr.GetSpellProcFlags(holder->GetSpellProto());
+    if (!procFlags)
+        return;
+
+    // after holders of the same spell, like the multimap insert, so procs keep the m_spellAuraHolders order
+    auto itr = std::upper_bound(m_procHolders.begin(), m_procHolders.end(), holder->GetId(), [](uint32 spellId, ProcHolderEntry const& entry)
+    {
+        return spellId < entry.holder->GetId();
+    });
+    m_procHolders.insert(itr, { procFlags, holder });
+}
+
+void Unit::RebuildProcHoldersIfReloaded()
+{
+    uint32 generation = sSpellMgr.GetSpellProcEventGeneration();
+    if (m_procHoldersGeneration == generation)
+        return;
+
+    // spell_proc_event was reloaded, the proc flags of the present holders may have changed
+    m_procHoldersGeneration = generation;
+    m_procHolders.clear();
+    for (auto& itr : m_spellAuraHolders)
+        AddProcHolder(itr.second);
+}
+
+void Unit::RemoveProcHolder(SpellAuraHolder* holder)
+{
+    auto itr = std::find_if(m_procHolders.begin(), m_procHolders.end(), [holder](ProcHolderEntry const& entry) { return entry.holder == holder; });
+    if (itr != m_procHolders.end())
+        m_procHolders.erase(itr);
+}
+
+void Unit::RemoveModAura(Aura* aura, AuraType type)
+{
+    AuraList& auras = m_modAuras[type];
+    bool const queued = auras.HasHoles();
+    auras.remove(aura);
+    if (!queued && auras.HasHoles())
+        m_modAurasToCompact.push_back(type);
 }
 
 bool Unit::IsShapeShifted() const
@@ -13084,7 +13123,7 @@ bool Unit::TakeCharmOf(Unit* charmed, uint32 spellId, bool advertised /*= true*/
 
     // put charmed in combat with all charmers enemies - must be done after flags
     ThreatList const& list = getThreatManager().getThreatList();
-    for (auto& data : list)
+    for (auto data : list)
     {
         Unit* enemy = data->getTarget();
         if (charmed->CanAttack(enemy))
@@ -13434,11 +13473,13 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
+        target->m_events.VisitEvents([this](BasicEvent* basicEvent)
+        {
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
                 if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
                         event->GetSpell()->cancel();
+        });
     }
 }
 
@@ -13956,7 +13997,7 @@ Unit* Unit::SelectAttackingTarget(AttackingTarget target, uint32 position, Spell
             suitableUnits.reserve(threatlist.size() - position);
 
             if (position)
-                advance(itr, position);
+                std::advance(itr, position);
 
             for (; itr != threatlist.end(); ++itr)
             {
@@ -13975,7 +14016,7 @@ Unit* Unit::SelectAttackingTarget(AttackingTarget target, uint32 position, Spell
         case ATTACKING_TARGET_TOPAGGRO:
         {
             if (position)
-                advance(itr, position);
+                std::advance(itr, position);
 
             for (; itr != threatlist.end(); ++itr)
             {
@@ -13993,7 +14034,7 @@ Unit* Unit::SelectAttackingTarget(AttackingTarget target, uint32 position, Spell
             ThreatList::const_reverse_iterator ritr = threatlist.rbegin();
 
             if (position)
-                advance(ritr, position);
+                std::advance(ritr, position);
 
             for (; ritr != threatlist.rend(); ++ritr)
             {
@@ -14068,7 +14109,7 @@ void Unit::SelectAttackingTargets(std::vector<Unit*>& selectedTargets, Attacking
         case ATTACKING_TARGET_ALL_SUITABLE:
         {
             if (position)
-                advance(itr, position);
+                std::advance(itr, position);
 
             for (; itr != threatlist.end(); ++itr)
             {
@@ -43,6 +43,7 @@
 #include "Server/DBCStructure.h"
 #include "Server/WorldPacket.h"
 #include "Util/Timer.h"
+#include "Util/StableVector.h"
 #include "AI/BaseAI/UnitAI.h"
 #include "Spells/SpellDefines.h"
 #include "Maps/SpawnGroupDefines.h"
@@ -1148,7 +1149,7 @@ class Unit : public WorldObject
         typedef std::pair<SpellAuraHolderMap::iterator, SpellAuraHolderMap::iterator> SpellAuraHolderBounds;
         typedef std::pair<SpellAuraHolderMap::const_iterator, SpellAuraHolderMap::const_iterator> SpellAuraHolderConstBounds;
         typedef std::list<SpellAuraHolder*> SpellAuraHolderList;
-        typedef std::list<Aura*> AuraList;
+        typedef StableVector<Aura*> AuraList;
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32 /*playerGuidLow*/> ComboPointHolderSet;
         typedef std::map<uint8 /*slot*/, uint32 /*spellId*/> VisibleAuraMap;
@@ -2714,6 +2715,14 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+        // holders of m_spellAuraHolders that can proc, in the same order, with the proc flags they react to
+        struct ProcHolderEntry
+        {
+            uint32 procFlags;
+            SpellAuraHolder* holder;
+        };
+        std::vector<ProcHolderEntry> m_procHolders;
+        uint32 m_procHoldersGeneration;                     // spell_proc_event load the flags of m_procHolders were read from
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
@@ -2734,6 +2743,7 @@ class Unit : public WorldObject
         std::map<uint32, Creature*> m_creatures;
 
         AuraList m_modAuras[TOTAL_AURAS];
+        std::vector<AuraType> m_modAurasToCompact;          // m_modAuras lists with removed entries, compacted in CleanupDeletedAuras
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
 
         enum class AttackPowerMod
@@ -2820,6 +2830,10 @@ class Unit : public WorldObject
 
     private:
         void CleanupDeletedAuras();
+        void RemoveModAura(Aura* aura, AuraType type);
+        void AddProcHolder(SpellAuraHolder* holder);
+        void RemoveProcHolder(SpellAuraHolder* holder);
+        void RebuildProcHoldersIfReloaded();
         void UpdateSplineMovement(uint32 t_diff);
 
         // player or player's pet
@@ -28,7 +28,7 @@
 #include "Entities/ObjectGuid.h"
 #include "Server/WorldSession.h"
 
-UpdateData::UpdateData() : m_data(1, {ByteBuffer(0), 0}), m_currentIndex(0)
+UpdateData::UpdateData() : m_data(1, {ByteBuffer(0), 0}), m_currentIndex(0), m_hasCreateBlocks(false)
 {
 }
 
@@ -44,6 +44,9 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid const& guid)
 
 void UpdateData::AddUpdateBlock(const ByteBuffer& block)
 {
+    if (block[0] == UPDATETYPE_CREATE_OBJECT || block[0] == UPDATETYPE_CREATE_OBJECT2)
+        m_hasCreateBlocks = true;
+
     const size_t existing = (128 + (9 * m_outOfRangeGUIDs.size()) + m_data[m_currentIndex].m_buffer.size());
 
     if ((existing + block.size()) < MAX_NETCLIENT_PACKET_SIZE)
@@ -65,16 +68,47 @@ void UpdateData::AddAfterCreatePacket(const WorldPacket& data)
     m_afterCreatePacket.emplace_back(data);
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+// deflate state kept by every thread compressing update packets, only reset between two packets
+// instead of allocating and initializing a new one each time
+struct UpdateCompressionStream
 {
-    z_stream c_stream;
+    z_stream stream;
+    int level = -1;
+
+    ~UpdateCompressionStream()
+    {
+        if (level >= 0)
+            deflateEnd(&stream);
+    }
+
+    int Init(int compressionLevel)
+    {
+        if (level >= 0)
+        {
+            if (level == compressionLevel)
+                return deflateReset(&stream);
+
+            deflateEnd(&stream);
+            level = -1;
+        }
+
+        stream.zalloc = (alloc_func)nullptr;
+        stream.zfree = (free_func)nullptr;
+        stream.opaque = (voidpf)nullptr;
+
+        int z_res = deflateInit(&stream, compressionLevel);
+        if (z_res == Z_OK)
+            level = compressionLevel;
+        return z_res;
+    }
+};
 
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+static thread_local UpdateCompressionStream compressionStream;
 
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size, uint32 compressionLevel)
+{
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    int z_res = compressionStream.Init(compressionLevel);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
@@ -82,6 +116,7 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
+    z_stream& c_stream = compressionStream.stream;
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
     c_stream.next_in = (Bytef*)src;
@@ -110,18 +145,10 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
 }
 
-WorldPacket UpdateData::BuildPacket(size_t index)
+WorldPacket UpdateData::BuildPacket(size_t index, uint32 compressionLevel)
 {
     WorldPacket packet;
     MANGOS_ASSERT(packet.empty());                         // shouldn't happen
@@ -143,13 +170,14 @@ WorldPacket UpdateData::BuildPacket(size_t index)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                        // compress large packets
+    if (pSize > sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD)) // compress large packets
     {
         uint32 destsize = compressBound(pSize);
         packet.resize(destsize + sizeof(uint32));
 
         packet.put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet.contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        Compress(const_cast<uint8*>(packet.contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize,
+            compressionLevel ? compressionLevel : sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
         if (destsize == 0)
             return packet;
 
@@ -169,16 +197,17 @@ void UpdateData::Clear()
 {
     m_data.clear();
     m_outOfRangeGUIDs.clear();
+    m_hasCreateBlocks = false;
 }
 
-void UpdateData::SendData(WorldSession& session)
+void UpdateData::SendData(WorldSession& session, uint32 compressionLevel)
 {
     if (!HasData())
         return;
 
     for (size_t i = 0; i < GetPacketCount(); ++i)
     {
-        WorldPacket packet = BuildPacket(i);
+        WorldPacket packet = BuildPacket(i, compressionLevel);
         session.SendPacket(packet);
     }
 
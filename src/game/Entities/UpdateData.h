@@ -57,6 +57,23 @@ struct BufferPair
     uint32 m_blockCount;
 };
 
+// Values update blocks of one object already built for other observers in the same update,
+// keyed by the visibility of the fields for the observer (see Object::GetSharedValuesUpdateKey)
+struct UpdateValuesCache
+{
+    std::vector<std::pair<uint32, ByteBuffer>> m_blocks;
+    uint32 m_hits = 0;
+    uint32 m_misses = 0;
+
+    ByteBuffer const* Find(uint32 key) const
+    {
+        for (auto& block : m_blocks)
+            if (block.first == key)
+                return &block.second;
+        return nullptr;
+    }
+};
+
 class UpdateData
 {
     public:
@@ -66,22 +83,26 @@ class UpdateData
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
         void AddAfterCreatePacket(const WorldPacket& data);
-        WorldPacket BuildPacket(size_t index); // Copy Elision is a thing
+        WorldPacket BuildPacket(size_t index, uint32 compressionLevel = 0); // Copy Elision is a thing
         bool HasData() const { return m_data[0].m_buffer.size() > 0 || !m_outOfRangeGUIDs.empty(); }
+        // only values and movement blocks, nothing is created or removed at the client
+        bool IsValuesOnly() const { return !m_hasCreateBlocks && m_outOfRangeGUIDs.empty() && m_afterCreatePacket.empty(); }
         size_t GetPacketCount() const { return m_data.size(); }
         void Clear();
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
-        void SendData(WorldSession& session);
+        // compressionLevel 0 uses the configured level
+        void SendData(WorldSession& session, uint32 compressionLevel = 0);
 
     protected:
         GuidSet m_outOfRangeGUIDs;
         std::vector<BufferPair> m_data;
         uint32 m_currentIndex;
+        bool m_hasCreateBlocks;
 
         std::vector<WorldPacket> m_afterCreatePacket;
 
-        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        static void Compress(void* dst, uint32* dst_size, void* src, int src_size, uint32 compressionLevel);
 };
 #endif
@@ -38,30 +38,32 @@ INSTANTIATE_CLASS_MUTEX(ObjectAccessor, std::mutex);
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap[o->GetObjectGuid()] = o;
+    m_objectMap.Insert(o->GetObjectGuid(), o);
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    WriteGuard guard(i_lock);
-    m_objectMap.erase(o->GetObjectGuid());
+    m_objectMap.Remove(o->GetObjectGuid());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    ReadGuard guard(i_lock);
-    typename MapType::iterator itr = m_objectMap.find(guid);
-    return (itr != m_objectMap.end()) ? itr->second : nullptr;
+    return m_objectMap.Find(guid);
 }
 
 template<class T>
-typename HashMapHolder<T>::MapType& HashMapHolder<T>::GetContainer() { return m_objectMap; }
+void HashMapHolder<T>::DoForAll(std::function<void(T*)> const& executor)
+{
+    m_objectMap.DoForAll(executor);
+}
 
 template<class T>
-typename HashMapHolder<T>::LockType& HashMapHolder<T>::GetLock() { return i_lock; }
+uint64 HashMapHolder<T>::GetContentionCount()
+{
+    return m_objectMap.GetContentionCount();
+}
 
 ObjectAccessor::ObjectAccessor() {}
 ObjectAccessor::~ObjectAccessor()
@@ -122,27 +124,27 @@ Player* ObjectAccessor::FindPlayerByName(char const* name, bool inWorld /*=true*
 
 void ObjectAccessor::SaveAllPlayers() const
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (auto& itr : m)
+    HashMapHolder<Player>::DoForAll([](Player* plr)
     {
-        if (itr.second->IsInWorld())
-            itr.second->GetMap()->GetMessager().AddMessage([guid = itr.second->GetObjectGuid()](Map* map)
+        if (plr->IsInWorld())
+            plr->GetMap()->GetMessager().AddMessage([guid = plr->GetObjectGuid()](Map* map)
             {
                 if (Player* player = map->GetPlayer(guid))
                     player->SaveToDB();
             });
         else
-            itr.second->SaveToDB();
-    }
+            plr->SaveToDB();
+    });
 }
 
 void ObjectAccessor::ExecuteOnAllPlayers(std::function<void(Player*)> executor)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        executor(itr->second);
+    HashMapHolder<Player>::DoForAll(executor);
+}
+
+uint64 ObjectAccessor::GetLookupContentionCount()
+{
+    return HashMapHolder<Player>::GetContentionCount() + HashMapHolder<Corpse>::GetContentionCount() + PlayerNameMapHolder::GetContentionCount();
 }
 
 void ObjectAccessor::KickPlayer(ObjectGuid guid)
@@ -323,7 +325,6 @@ void ObjectAccessor::RemoveObject(Player* player)
 /// Define the static member of HashMapHolder
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> std::mutex HashMapHolder<T>::i_lock;
 
 /// Global definitions for the hashmap storage
 
@@ -332,12 +333,12 @@ template class HashMapHolder<Corpse>;
 
 void PlayerNameMapHolder::Insert(Player* p)
 {
-    m_objectMap[p->GetNameStr()] = p;
+    m_objectMap.Insert(p->GetNameStr(), p);
 }
 
 void PlayerNameMapHolder::Remove(Player* p)
 {
-    m_objectMap.erase(p->GetNameStr());
+    m_objectMap.Remove(p->GetNameStr());
 }
 
 Player* PlayerNameMapHolder::Find(std::string const& name)
@@ -346,8 +347,12 @@ Player* PlayerNameMapHolder::Find(std::string const& name)
     if (!normalizePlayerName(charName))
         return nullptr;
 
-    MapType::iterator itr = m_objectMap.find(charName);
-    return (itr != m_objectMap.end()) ? itr->second : nullptr;
+    return m_objectMap.Find(charName);
+}
+
+uint64 PlayerNameMapHolder::GetContentionCount()
+{
+    return m_objectMap.GetContentionCount();
 }
 
 /// Define the static member of PlayerNameMapHolder
@@ -23,6 +23,7 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include "Policies/ThreadingModel.h"
+#include "Multithreading/ShardedMap.h"
 
 #include "Entities/UpdateData.h"
 
@@ -38,15 +39,13 @@ class Unit;
 class WorldObject;
 class Map;
 
+// looked up from all map threads, so the maps are sharded and lookups only take a shared lock on one shard
 template <class T>
 class HashMapHolder
 {
     public:
 
-        typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        typedef ShardedMap<ObjectGuid, T*> MapType;
 
         static void Insert(T* o);
 
@@ -54,28 +53,30 @@ class HashMapHolder
 
         static T* Find(ObjectGuid guid);
 
-        static MapType& GetContainer();
+        // the executor must not add or remove objects
+        static void DoForAll(std::function<void(T*)> const& executor);
 
-        static LockType& GetLock();
+        static uint64 GetContentionCount();
 
     private:
 
         // Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
         static MapType  m_objectMap;
 };
 
 class PlayerNameMapHolder
 {
     public:
-        typedef std::unordered_map<std::string, Player*> MapType;
+        typedef ShardedMap<std::string, Player*> MapType;
 
         static void Insert(Player* p);
         static void Remove(Player* p);
         static Player* Find(std::string const& name);
 
+        static uint64 GetContentionCount();
+
     private:
 
         // Non instanceable only static
@@ -105,14 +106,13 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         static Player* FindPlayerByName(char const* name, bool inWorld = true);
         static void KickPlayer(ObjectGuid guid);
 
-        HashMapHolder<Player>::MapType& GetPlayers() const
-        {
-            return HashMapHolder<Player>::GetContainer();
-        }
-
         void SaveAllPlayers() const;
+        // the executor must not add or remove players
         void ExecuteOnAllPlayers(std::function<void(Player*)> executor);
 
+        // lookup lock acquisitions which had to wait since start
+        static uint64 GetLookupContentionCount();
+
         // Corpse access
         Corpse* GetCorpseForPlayerGUID(ObjectGuid guid);
         static Corpse* GetCorpseInMap(ObjectGuid guid, uint32 mapid);
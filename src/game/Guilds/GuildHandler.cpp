@@ -907,7 +907,7 @@ void WorldSession::HandleGuildBankDepositMoney(WorldPacket& recv_data)
     if (!pGuild->GetPurchasedTabs())
         return;
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(GetPlayer()->GetGUIDLow());
 
     pGuild->SetBankMoney(pGuild->GetGuildBankMoney() + money);
     GetPlayer()->ModifyMoney(-int(money));
@@ -961,7 +961,7 @@ void WorldSession::HandleGuildBankWithdrawMoney(WorldPacket& recv_data)
     if (!pGuild->HasRankRight(GetPlayer()->GetRank(), GR_RIGHT_WITHDRAW_GOLD))
         return;
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(GetPlayer()->GetGUIDLow());
 
     if (!pGuild->MemberMoneyWithdraw(money, GetPlayer()->GetGUIDLow()))
     {
@@ -1791,7 +1791,7 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
         {
             if (creature->GetSettings().HasFlag(CreatureStaticFlags3::CAN_BE_MULTITAPPED))
             {
-                for (auto& threatEntry : creature->getThreatManager().getThreatList())
+                for (auto threatEntry : creature->getThreatManager().getThreatList())
                     if (threatEntry->getTarget()->IsPlayer())
                         m_ownerSet.insert(threatEntry->getTarget()->GetObjectGuid());
             }
@@ -221,7 +221,7 @@ void MailDraft::SendReturnToSender(uint32 sender_acc, ObjectGuid sender_guid, Ob
         needItemDelay = sender_acc != rc_account;
 
         // set owner to new receiver (to prevent delete item with sender char deleting)
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(receiver_guid.GetCounter());
         for (auto& m_item : m_items)
         {
             Item* item = m_item.second;
@@ -290,7 +290,7 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
     std::string safe_body = GetBody();
     CharacterDatabase.escape_string(safe_body);
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(receiver.GetPlayerGuid().GetCounter());
     CharacterDatabase.PExecute("INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,body,has_items,expire_time,deliver_time,money,cod,checked) "
                                "VALUES ('%u', '%u', '%u', '%u', '%u', '%u', '%s', '%s', '%u', '" UI64FMTD "','" UI64FMTD "', '%u', '%u', '%u')",
                                mailId, sender.GetMailMessageType(), sender.GetStationery(), GetMailTemplateId(), sender.GetSenderId(), receiver.GetPlayerGuid().GetCounter(), safe_subject.c_str(), safe_body.c_str(), (has_items ? 1 : 0), (uint64)expire_time, (uint64)deliver_time, m_money, m_COD, checked);
@@ -356,7 +356,7 @@ void Mail::prepareTemplateItems(Player* receiver)
 
     has_items = true;
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(receiver->GetGUIDLow());
     CharacterDatabase.PExecute("UPDATE mail SET has_items = 1 WHERE id = %u", messageID);
 
     // mailLoot can be empty
@@ -306,7 +306,7 @@ void WorldSession::HandleSendMail(WorldPacket& recv_data)
                 }
 
                 pl->MoveItemFromInventory(items[i]->GetBagSlot(), item->GetSlot(), true);
-                CharacterDatabase.BeginTransaction();
+                CharacterDatabase.BeginTransaction(pl->GetGUIDLow(), rc.GetCounter());
                 item->DeleteFromInventoryDB();              // deletes item from character's inventory
                 item->SaveToDB();                           // recursive and not have transaction guard into self, item not in inventory and can be save standalone
                 // owner in data will set at mail receive and item extracting
@@ -336,7 +336,7 @@ void WorldSession::HandleSendMail(WorldPacket& recv_data)
     .SetCOD(COD)
     .SendMailTo(MailReceiver(receive, rc), pl, body.empty() ? MAIL_CHECK_MASK_COPIED : MAIL_CHECK_MASK_HAS_BODY, deliver_delay);
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(pl->GetGUIDLow());
     pl->SaveInventoryAndGoldToDB();
     CharacterDatabase.CommitTransaction();
 }
@@ -439,7 +439,7 @@ void WorldSession::HandleMailReturnToSender(WorldPacket& recv_data)
 
     // we can return mail now
     // so firstly delete the old one
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(pl->GetGUIDLow());
     CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", mailId);
     // needed?
     CharacterDatabase.PExecute("DELETE FROM mail_items WHERE mail_id = '%u'", mailId);
@@ -560,7 +560,7 @@ void WorldSession::HandleMailTakeItem(WorldPacket& recv_data)
         uint32 count = it->GetCount();                      // save counts before store and possible merge with deleting
         pl->MoveItemToInventory(dest, it, true);
 
-        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.BeginTransaction(pl->GetGUIDLow());
         pl->SaveInventoryAndGoldToDB();
         pl->_SaveMail();
         CharacterDatabase.CommitTransaction();
@@ -601,7 +601,7 @@ void WorldSession::HandleMailTakeMoney(WorldPacket& recv_data)
     pl->m_mailsUpdated = true;
 
     // save money and mail to prevent cheating
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(pl->GetGUIDLow());
     pl->SaveGoldToDB();
     pl->_SaveMail();
     CharacterDatabase.CommitTransaction();
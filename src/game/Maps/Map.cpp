@@ -44,6 +44,7 @@
 #include "Vmap/GameObjectModel.h"
 #include "LFG/LFGMgr.h"
 #include "BattleGround/BattleGroundMgr.h"
+#include "Maps/MapWorkers.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
@@ -54,6 +55,7 @@
 #endif
 
 #include <time.h>
+#include <latch>
 
 Map::~Map()
 {
@@ -249,7 +251,8 @@ void Map::LoadMapAndVMap(int gx, int gy)
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0), m_clientUpdateTimer(0), m_clientUpdateTick(0),
-      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
+      m_pendingUpdateDiff(0), m_updateInterval(0),
+      m_compressionLevel(sWorld.getConfig(CONFIG_UINT32_COMPRESSION)), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_defaultLight(GetDefaultMapLight(id)), m_spawnManager(*this),
@@ -513,6 +516,11 @@ uint32 Map::GetLoadedGridsCount()
     return count;
 }
 
+void Map::SetUpdateWorker(std::unique_ptr<MapUpdateWorker> worker)
+{
+    m_updateWorker = std::move(worker);
+}
+
 void Map::ForceLoadGrid(float x, float y)
 {
     if (!IsLoaded(x, y))
@@ -544,6 +552,9 @@ void Map::CreatePlayerOnClient(Player* player)
 
 bool Map::Add(Player* player)
 {
+    // back to full rate at the next tick
+    m_updateInterval = 0;
+
     player->GetMapRef().link(this, player);
     player->SetMap(this);
 
@@ -798,6 +809,68 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
     }
 }
 
+bool Map::IsUpdateDue(uint32 diff)
+{
+    m_pendingUpdateDiff += diff;
+    return m_pendingUpdateDiff >= m_updateInterval;
+}
+
+void Map::ScheduledUpdate()
+{
+    uint32 diff = m_pendingUpdateDiff;
+    m_pendingUpdateDiff = 0;
+
+    uint32 startTime = WorldTimer::getMSTime();
+    Update(diff);
+    uint32 updateCost = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+    UpdateTickInterval(updateCost);
+    UpdateCompressionLevel(updateCost);
+
+    // packet building and compression overlaps with the update of the next maps
+    if (!m_pendingClientUpdates.empty())
+    {
+        sMapMgr.ScheduleClientUpdates(std::move(m_pendingClientUpdates), m_compressionLevel);
+        m_pendingClientUpdates.clear();
+    }
+}
+
+void Map::UpdateTickInterval(uint32 updateCost)
+{
+    // zero updates the map at every map manager tick
+    m_updateInterval = 0;
+
+    if (!sWorld.getConfig(CONFIG_BOOL_MAP_ADAPTIVE_TICK))
+        return;
+
+    for (const auto& itr : m_mapRefManager)
+        if (itr.getSource()->IsInCombat())
+            return;
+
+    // sessions of the players are handled with the map update, never delay them beyond the configured interval
+    if (HavePlayers())
+    {
+        m_updateInterval = sWorld.getConfig(CONFIG_UINT32_MAP_QUIET_INTERVAL);
+        return;
+    }
+
+    m_updateInterval = std::max(sWorld.getConfig(CONFIG_UINT32_MAP_IDLE_INTERVAL), updateCost * 2);
+}
+
+void Map::UpdateCompressionLevel(uint32 updateCost)
+{
+    uint32 configLevel = sWorld.getConfig(CONFIG_UINT32_COMPRESSION);
+    if (!sWorld.getConfig(CONFIG_BOOL_COMPRESSION_ADAPTIVE))
+    {
+        m_compressionLevel = configLevel;
+        return;
+    }
+
+    if (updateCost > sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE))
+        m_compressionLevel = std::max(m_compressionLevel, 2u) - 1;
+    else
+        m_compressionLevel = std::min(m_compressionLevel + 1, configLevel);
+}
+
 void Map::Update(const uint32& t_diff)
 {
     m_clientUpdateTimer += t_diff;
@@ -2936,10 +3009,59 @@ void Map::UpdateVisibility(UpdateDataMapType& update_players)
     }
 }
 
+uint32 Map::GetUpdateDataShardCount() const
+{
+    uint32 minPlayers = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_DATA_SHARD_PLAYERS);
+    if (!minPlayers || !sMapMgr.GetUpdateDataUpdater())
+        return 1;
+
+    uint32 shardCount = m_mapRefManager.getSize() / minPlayers;
+    return std::clamp<uint32>(shardCount, 1, sWorld.getConfig(CONFIG_UINT32_NUM_MAP_UPDATE_DATA_SHARD_THREADS) + 1);
+}
+
+void Map::BuildUpdateDataInShards(uint32 shardCount, std::function<void(uint32)> const& build)
+{
+    MapUpdater* updater = sMapMgr.GetUpdateDataUpdater();
+    std::latch done(shardCount - 1);
+    for (uint32 shard = 1; shard < shardCount; ++shard)
+        updater->schedule_update(new UpdateDataShardWorker(build, shard, done, *updater));
+
+    build(0);
+    done.wait();
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
 
+    // players are split in shards built concurrently on the update data workers, each shard fills the data of its own players only
+    uint32 shardCount = GetUpdateDataShardCount();
+    std::vector<UpdateDataMapType> shards(shardCount);
+
+    if (shardCount > 1)
+    {
+        std::vector<Object*> objects;
+        while (!m_objectsToClientUpdate.empty())
+        {
+            Object* obj = *m_objectsToClientUpdate.begin();
+            m_objectsToClientUpdate.erase(m_objectsToClientUpdate.begin());
+            obj->PrepareUpdateData();
+            objects.push_back(obj);
+        }
+
+        BuildUpdateDataInShards(shardCount, [&](uint32 shard)
+        {
+            for (Object* obj : objects)
+                obj->BuildUpdateDataForShard(shards[shard], shard, shardCount);
+        });
+
+        for (Object* obj : objects)
+            obj->FinishUpdateData();
+
+        for (auto& shard : shards)
+            update_players.merge(shard);
+    }
+
     while (!m_objectsToClientUpdate.empty()) // do it first to avoid sending update and create to same obj
     {
         Object* obj = *m_objectsToClientUpdate.begin();
@@ -2949,6 +3071,48 @@ void Map::SendObjectUpdates()
 
     UpdateVisibility(update_players);
 
+    if (shardCount > 1)
+    {
+        std::unordered_map<Object*, PlayerSet> visibilityAdded;
+        std::swap(visibilityAdded, m_visibilityAdded);
+
+        for (auto itr = update_players.begin(); itr != update_players.end();)
+        {
+            uint32 shard = Object::GetUpdateShard(itr->first, shardCount);
+            shards[shard].insert(update_players.extract(itr++));
+        }
+
+        BuildUpdateDataInShards(shardCount, [&](uint32 shard)
+        {
+            for (auto& visData : visibilityAdded)
+            {
+                bool built = false;
+                for (Player* player : visData.second)
+                {
+                    if (Object::IsInUpdateShard(player, shard, shardCount))
+                    {
+                        visData.first->BuildCreateDataForPlayer(player, shards[shard], false);
+                        built = true;
+                    }
+                }
+
+                if (built && visData.first->IsUnit())
+                {
+                    WorldPacket packet = Player::BuildAurasForTarget(static_cast<Unit const*>(visData.first));
+                    for (Player* player : visData.second)
+                        if (Object::IsInUpdateShard(player, shard, shardCount))
+                            shards[shard].find(player)->second.AddAfterCreatePacket(packet);
+                }
+            }
+        });
+
+        for (auto& visData : visibilityAdded)
+            visData.first->SetItsNewObject(false);
+
+        for (auto& shard : shards)
+            update_players.merge(shard);
+    }
+
     {
         std::unordered_map<Object*, PlayerSet> visibilityAdded;
         std::swap(visibilityAdded, m_visibilityAdded);
@@ -2984,9 +3148,33 @@ void Map::SendObjectUpdates()
         }
     }
 
-    for (auto& update_player : update_players)
+#ifdef BUILD_METRICS
+    uint32 valuesCacheHits = m_valuesCacheHits.exchange(0);
+    uint32 valuesCacheMisses = m_valuesCacheMisses.exchange(0);
+    if (valuesCacheHits || valuesCacheMisses)
+    {
+        metric::measurement meas("map.update.values_cache", {
+            { "map_id", std::to_string(i_id) },
+            { "instance_id", std::to_string(i_InstanceId) }
+        });
+        meas.add_field("hits", std::to_string(valuesCacheHits));
+        meas.add_field("misses", std::to_string(valuesCacheMisses));
+        meas.add_field("hit_rate", std::to_string(float(valuesCacheHits) / (valuesCacheHits + valuesCacheMisses)));
+    }
+#endif
+
+    // packets sent directly after this point may refer to objects created or removed here, so only pure values
+    // and movement updates are left to be sent once the whole map update is done, see Map::ScheduledUpdate
+    bool deferValuesUpdates = sMapMgr.CanScheduleClientUpdates();
+    for (auto itr = update_players.begin(); itr != update_players.end();)
     {
-        update_player.second.SendData(*update_player.first->GetSession());
+        if (deferValuesUpdates && itr->second.IsValuesOnly())
+            m_pendingClientUpdates.insert(update_players.extract(itr++));
+        else
+        {
+            itr->second.SendData(*itr->first->GetSession(), m_compressionLevel);
+            ++itr;
+        }
     }
 }
 
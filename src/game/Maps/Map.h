@@ -63,6 +63,7 @@ class WeatherSystem;
 class GenericTransport;
 namespace MaNGOS { struct ObjectUpdater; }
 class Transport;
+class MapUpdateWorker;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -158,6 +159,10 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32&);
 
+        // adaptive tick rate - elapsed time is accumulated until the map's own update interval passed
+        bool IsUpdateDue(uint32 diff);
+        void ScheduledUpdate();
+
         uint64 PerformObjectUpdate(uint32 t_diff, WorldObjectUnSet& objToUpdate);
 
         void MessageBroadcast(Player const*, WorldPacket const&, bool to_self);
@@ -427,6 +432,13 @@ class Map : public GridRefManager<NGridType>
 
         Messager<Map>& GetMessager() { return m_messager; }
 
+        // values update blocks shared between observers, see Object::BuildValuesUpdateBlockForPlayer
+        void AddValuesCacheStats(uint32 hits, uint32 misses) { m_valuesCacheHits += hits; m_valuesCacheMisses += misses; }
+
+        // reused every tick by the map updater
+        MapUpdateWorker* GetUpdateWorker() const { return m_updateWorker.get(); }
+        void SetUpdateWorker(std::unique_ptr<MapUpdateWorker> worker);
+
         typedef std::set<Transport*> TransportSet;
         GenericTransport* GetTransport(ObjectGuid guid);
         TransportSet const& GetTransports() { return m_transports; }
@@ -511,13 +523,21 @@ class Map : public GridRefManager<NGridType>
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
 
+        void UpdateTickInterval(uint32 updateCost);
+        void UpdateCompressionLevel(uint32 updateCost);
+
         void UpdateVisibility(UpdateDataMapType& update_players);
         void SendObjectUpdates();
+        uint32 GetUpdateDataShardCount() const;
+        void BuildUpdateDataInShards(uint32 shardCount, std::function<void(uint32)> const& build);
         std::set<Object*> m_objectsToClientUpdate;
         std::set<std::pair<Object*, ObjectGuid>> m_objectsToClientCreateUpdate;
         std::set<Object*> m_objectsToClientMovementUpdate;
         std::vector<std::pair<GuidSet, ObjectGuid>> m_objectsToClientRemove;
         std::unordered_map<Object*, PlayerSet> m_visibilityAdded;
+        std::atomic<uint32> m_valuesCacheHits;
+        std::atomic<uint32> m_valuesCacheMisses;
+        UpdateDataMapType m_pendingClientUpdates;                   // built at the end of the tick, sent by MapManager::ScheduleClientUpdates
 
         std::set<WorldObject*> m_largeObjects;
         std::set<WorldObject*> m_infiniteObjects;
@@ -532,6 +552,9 @@ class Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         uint32 m_clientUpdateTimer;
         uint32 m_clientUpdateTick;
+        uint32 m_pendingUpdateDiff;
+        uint32 m_updateInterval;
+        uint32 m_compressionLevel;                          // of the client updates, lowered while the map is over budget
         float m_VisibleDistance;
         MapPersistentState* m_persistentState;
 
@@ -551,6 +574,8 @@ class Map : public GridRefManager<NGridType>
 
         Messager<Map> m_messager;
 
+        std::unique_ptr<MapUpdateWorker> m_updateWorker;
+
         GraveyardManager m_graveyardManager;
     private:
         time_t i_gridExpiry;
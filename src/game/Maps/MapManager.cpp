@@ -30,12 +30,16 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <future>
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
 
 MapManager::MapManager()
-    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)), m_transportCounter(0)
+    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)), m_nextUpdaterAffinity(0), m_updaterSteals(0), m_transportCounter(0)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
@@ -55,6 +59,9 @@ void MapManager::Initialize()
     int num_threads(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS));
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 updateDataThreads = sWorld.getConfig(CONFIG_UINT32_NUM_MAP_UPDATE_DATA_SHARD_THREADS))
+        m_updateDataUpdater.activate(updateDataThreads);
 }
 
 void MapManager::InitStateMachine()
@@ -199,15 +206,36 @@ void MapManager::Update(uint32 diff)
 
     for (auto& map : i_maps)
     {
+        // maps without combat or players may skip ticks, they get the whole elapsed time at their next update
+        if (!map.second->IsUpdateDue((uint32)i_timer.GetCurrent()))
+            continue;
+
         if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
+        {
+            MapUpdateWorker* worker = map.second->GetUpdateWorker();
+            if (!worker)
+            {
+                // spread new maps over the threads, they keep their thread as long as it is not overloaded
+                map.second->SetUpdateWorker(std::make_unique<MapUpdateWorker>(*map.second, m_nextUpdaterAffinity++, m_updater));
+                worker = map.second->GetUpdateWorker();
+            }
+            m_updater.schedule_update(worker);
+        }
         else
-            map.second->Update((uint32)i_timer.GetCurrent());
+            map.second->ScheduledUpdate();
     }
 
     if (m_updater.activated())
+    {
         m_updater.wait();
 
+        m_updaterSteals = m_updater.reset_steal_counter();
+#ifdef BUILD_METRICS
+        metric::measurement meas("map.updater");
+        meas.add_field("steals", std::to_string(m_updaterSteals));
+#endif
+    }
+
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
     while (iter != i_maps.end())
@@ -226,6 +254,16 @@ void MapManager::Update(uint32 diff)
     i_timer.SetCurrent(0);
 }
 
+bool MapManager::CanScheduleClientUpdates()
+{
+    return m_updater.activated() && sWorld.getConfig(CONFIG_BOOL_MAP_ASYNC_CLIENT_UPDATES);
+}
+
+void MapManager::ScheduleClientUpdates(UpdateDataMapType&& updates, uint32 compressionLevel)
+{
+    m_updater.schedule_update(new ClientUpdateWorker(std::move(updates), compressionLevel, m_updater));
+}
+
 void MapManager::RemoveAllObjectsInRemoveList()
 {
     for (auto& i_map : i_maps)
@@ -259,6 +297,9 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (m_updateDataUpdater.activated())
+        m_updateDataUpdater.deactivate();
+
     TerrainManager::Instance().UnloadAll();
 }
 
@@ -156,6 +156,16 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         uint32 GetTransportCounter() const { return m_transportCounter; }
 
+        // pool building the client update data of crowded maps in shards, nullptr if disabled
+        MapUpdater* GetUpdateDataUpdater() { return m_updateDataUpdater.activated() ? &m_updateDataUpdater : nullptr; }
+        // maps taken over from a busy updater thread during the last tick
+        uint32 GetUpdaterSteals() const { return m_updaterSteals; }
+
+        // client updates of a map are built into packets, compressed and sent on the map update threads
+        // while the other maps are still updated, all of them are sent before MapManager::Update returns
+        bool CanScheduleClientUpdates();
+        void ScheduleClientUpdates(UpdateDataMapType&& updates, uint32 compressionLevel);
+
     private:
 
         // debugging code, should be deleted some day
@@ -184,6 +194,9 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         std::atomic<uint32> i_MaxInstanceId;
         MapUpdater m_updater;
+        MapUpdater m_updateDataUpdater;
+        size_t m_nextUpdaterAffinity;
+        uint32 m_updaterSteals;
         uint32 m_transportCounter;
 };
 
@@ -19,10 +19,9 @@
 #include "MapUpdater.h"
 #include "MapWorkers.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), _pendingRequests(0), _queuedRequests(0), _nextQueue(0), _steals(0)
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    activate(num_threads);
 }
 
 void MapUpdater::activate(size_t num_threads)
@@ -30,25 +29,48 @@ void MapUpdater::activate(size_t num_threads)
     if (activated())
         return;
 
+    _cancelationToken = false;
+
+    // all queues must exist before the first thread starts looking for work to steal
+    for (size_t i = 0; i < num_threads; ++i)
+        _queues.push_back(std::make_unique<ThreadQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
-    _queue.Cancel();
+    for (auto& queue : _queues)
+    {
+        std::lock_guard<std::mutex> lock(queue->lock);
+        queue->condition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
         thread.join();
+
+    // release whatever was left behind
+    for (auto& queue : _queues)
+    {
+        for (Worker* request : queue->requests)
+            if (!request->IsRecycled())
+                delete request;
+        queue->requests.clear();
+    }
+
+    _workerThreads.clear();
+    _queues.clear();
+    _queuedRequests = 0;
 }
 
 void MapUpdater::wait()
 {
     std::unique_lock<std::mutex> lock(_lock);
 
-    while (pending_requests > 0)
+    while (_pendingRequests > 0)
         _condition.wait(lock);
 }
 
@@ -65,36 +87,114 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    // only the last finished request has to wake up the waiting thread
+    if (--_pendingRequests > 0)
+        return;
 
-    --pending_requests;
+    std::lock_guard<std::mutex> lock(_lock);
     _condition.notify_all();
 }
 
 void MapUpdater::schedule_update(Worker* worker)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    ++_pendingRequests;
+
+    size_t index = worker->GetAffinity();
+    if (index == Worker::NO_AFFINITY)
+        index = _nextQueue++;
+    index %= _queues.size();
+
+    ThreadQueue& queue = *_queues[index];
+    bool busy;
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.requests.push_back(worker);
+        ++_queuedRequests;
+        busy = !queue.sleeping || queue.requests.size() > 1;
+        queue.condition.notify_one();
+    }
 
-    ++pending_requests;
-    _queue.Push(std::move(worker));
+    // home thread will not get to it soon, let another one steal it
+    if (busy)
+        WakeIdleThread(index);
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WakeIdleThread(size_t busyIndex)
 {
-    while (true)
+    for (size_t i = 1; i < _queues.size(); ++i)
     {
-        Worker* request = nullptr;
+        ThreadQueue& queue = *_queues[(busyIndex + i) % _queues.size()];
+        if (!queue.sleeping)
+            continue;
 
-        _queue.WaitAndPop(request);
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.sleeping)
+            continue;
 
-        if (_cancelationToken)
+        queue.condition.notify_one();
+        return;
+    }
+}
+
+Worker* MapUpdater::PopRequest(size_t index)
+{
+    // own work first, oldest request first
+    {
+        ThreadQueue& queue = *_queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.requests.empty())
         {
-            delete request;
+            Worker* request = queue.requests.front();
+            queue.requests.pop_front();
+            --_queuedRequests;
+            return request;
+        }
+    }
+
+    // steal the most recently queued request of another thread, its owner will reach it last
+    for (size_t i = 1; i < _queues.size() && _queuedRequests > 0; ++i)
+    {
+        ThreadQueue& queue = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (queue.requests.empty())
+            continue;
+
+        Worker* request = queue.requests.back();
+        queue.requests.pop_back();
+        --_queuedRequests;
+        ++_steals;
+        return request;
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::WorkerThread(size_t index)
+{
+    ThreadQueue& queue = *_queues[index];
+
+    while (true)
+    {
+        if (_cancelationToken)
             return;
+
+        Worker* request = PopRequest(index);
+        if (!request)
+        {
+            std::unique_lock<std::mutex> lock(queue.lock);
+            queue.sleeping = true;
+            while (!_cancelationToken && queue.requests.empty() && _queuedRequests == 0)
+                queue.condition.wait(lock);
+            queue.sleeping = false;
+            continue;
         }
 
+        // the owner of a recycled worker may destroy it as soon as it reports being finished
+        bool recycled = request->IsRecycled();
+
         request->execute();
 
-        delete request;
+        if (!recycled)
+            delete request;
     }
-}
\ No newline at end of file
+}
@@ -20,20 +20,23 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "Util/ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <condition_variable>
 
 class Worker;
 
+// Each thread owns a queue and prefers the workers whose affinity points at it,
+// an idle thread steals from the back of a busy thread's queue
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _pendingRequests(0), _queuedRequests(0), _nextQueue(0), _steals(0) {}
         MapUpdater(size_t num_threads);
         MapUpdater(const MapUpdater&) = delete;
         
@@ -45,17 +48,33 @@ class MapUpdater
         void update_finished();
         void schedule_update(Worker* worker);
 
+        // number of workers executed by another thread than their home one since last call
+        uint32 reset_steal_counter() { return _steals.exchange(0); }
+
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        struct ThreadQueue
+        {
+            std::mutex lock;
+            std::condition_variable condition;
+            std::deque<Worker*> requests;
+            std::atomic<bool> sleeping = false;
+        };
+
+        std::vector<std::unique_ptr<ThreadQueue>> _queues;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
         std::mutex _lock;
         std::condition_variable _condition;
-        size_t pending_requests;
+        std::atomic<size_t> _pendingRequests;
+        std::atomic<size_t> _queuedRequests;
+        std::atomic<size_t> _nextQueue;
+        std::atomic<uint32> _steals;
 
-        void WorkerThread();
+        Worker* PopRequest(size_t index);
+        void WakeIdleThread(size_t busyIndex);
+        void WorkerThread(size_t index);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
@@ -24,38 +24,74 @@
 #include "MapUpdater.h"
 #include "MotionGenerators/MovementGenerator.h"
 #include "Entities/Object.h"
+#include "Entities/Player.h"
 #include "Platform/Define.h"
 
+#include <functional>
+#include <latch>
+#include <limits>
+
 class Worker
 {
     public:
-        Worker(MapUpdater& updater) : m_updater(updater) {}
+        static constexpr size_t NO_AFFINITY = std::numeric_limits<size_t>::max();
+
+        Worker(MapUpdater& updater, size_t affinity = NO_AFFINITY) : m_updater(updater), m_affinity(affinity) {}
         virtual ~Worker() = default;
         virtual void execute() {};
+        // recycled workers are owned elsewhere and not deleted by the updater once executed
+        virtual bool IsRecycled() const { return false; }
+
+        // preferred updater thread, other threads only take the worker over when that one is busy
+        size_t GetAffinity() const { return m_affinity; }
 
     protected:
         MapUpdater& GetWorker() { return m_updater; }
 
     private:
         MapUpdater& m_updater;
+        size_t m_affinity;
 };
 
+// Owned by its map and rescheduled every tick, keeping the same affinity so the map stays on the same thread
 class MapUpdateWorker : public Worker
 {
     public:
-        MapUpdateWorker(Map& map, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_map(map), m_diff(diff)
+        MapUpdateWorker(Map& map, size_t affinity, MapUpdater& updater) :
+            Worker(updater, affinity), m_map(map)
         {}
 
         void execute() override
         {
-            m_map.Update(m_diff);
+            m_map.ScheduledUpdate();
             GetWorker().update_finished();
         }
 
+        bool IsRecycled() const override { return true; }
+
     private:
         Map& m_map;
-        uint32 m_diff;
+};
+
+// Builds, compresses and sends the client updates collected by one map update
+class ClientUpdateWorker : public Worker
+{
+    public:
+        ClientUpdateWorker(UpdateDataMapType&& updates, uint32 compressionLevel, MapUpdater& updater) :
+            Worker(updater), m_updates(std::move(updates)), m_compressionLevel(compressionLevel)
+        {}
+
+        void execute() override
+        {
+            for (auto& update : m_updates)
+                update.second.SendData(*update.first->GetSession(), m_compressionLevel);
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        UpdateDataMapType m_updates;
+        uint32 m_compressionLevel;
 };
 
 class GridCrawler : public Worker
@@ -108,4 +144,26 @@ class ObjectUpdateWorker : public Worker
         uint32 m_diff;
 };
 
+// Builds the client update data of the players of one shard, see Map::SendObjectUpdates
+class UpdateDataShardWorker : public Worker
+{
+    public:
+        UpdateDataShardWorker(std::function<void(uint32)> const& build, uint32 shard, std::latch& done, MapUpdater& updater) :
+            Worker(updater), m_build(build), m_shard(shard), m_done(done)
+        {}
+
+        void execute() override
+        {
+            m_build(m_shard);
+
+            m_done.count_down();
+            GetWorker().update_finished();
+        }
+
+    private:
+        std::function<void(uint32)> const& m_build;
+        uint32 m_shard;
+        std::latch& m_done;
+};
+
 #endif //_MAP_WORKERS_H_INCLUDED
@@ -1366,6 +1366,7 @@ enum PacketProcessing
     PROCESS_THREADSAFE,                                     // packet is thread-safe - process it in Map::Update()
     PROCESS_MAP_THREAD,                                     // packet is map thread safe
     PROCESS_IMMEDIATE,                                      // packet is network thread safe
+    PROCESS_THREADSAFE_SESSION,                             // packet only reads shared data - may be processed in parallel with other sessions in World::UpdateSessions()
 };
 
 class WorldPacket;
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/SessionReceiveQueue.h"
+#include "Server/WorldPacket.h"
+
+SessionReceiveQueue::SessionReceiveQueue(size_t capacity) : m_ring(capacity), m_spilled(false), m_pushed(0), m_popped(0)
+{
+}
+
+SessionReceiveQueue::~SessionReceiveQueue()
+{
+}
+
+void SessionReceiveQueue::Push(std::unique_ptr<WorldPacket> packet)
+{
+    // only the session's socket pushes so this lock is uncontended, it covers the reconnect handover
+    // where the old and the new socket of a session may both still deliver
+    std::lock_guard<std::mutex> guard(m_producerLock);
+    m_pushed.fetch_add(1, std::memory_order_release);
+    if (m_spilled.load(std::memory_order_relaxed) || !m_ring.TryEnqueue(std::move(packet)))
+    {
+        m_spill.push_back(std::move(packet));
+        m_spilled.store(true, std::memory_order_release);
+    }
+}
+
+bool SessionReceiveQueue::Pop(std::unique_ptr<WorldPacket>& packet)
+{
+    // spilled packets taken earlier come before anything pushed to the ring since
+    if (m_drain.empty())
+    {
+        if (m_ring.Dequeue(packet))
+        {
+            m_popped.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+
+        if (!TakeSpill())
+            return false;
+    }
+
+    packet = std::move(m_drain.front());
+    m_drain.pop_front();
+    m_popped.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+WorldPacket* SessionReceiveQueue::Front()
+{
+    if (m_drain.empty())
+    {
+        if (std::unique_ptr<WorldPacket>* packet = m_ring.Front())
+            return packet->get();
+
+        if (!TakeSpill())
+            return nullptr;
+    }
+
+    return m_drain.front().get();
+}
+
+// moves all queued packets to the drain list once the ring ran empty and the producer spilled
+bool SessionReceiveQueue::TakeSpill()
+{
+    if (!m_spilled.load(std::memory_order_acquire))
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_producerLock);
+
+    // the ring may have been refilled since it looked empty, those packets are older than the spill list
+    std::unique_ptr<WorldPacket> packet;
+    while (m_ring.Dequeue(packet))
+        m_drain.push_back(std::move(packet));
+
+    for (auto& spilled : m_spill)
+        m_drain.push_back(std::move(spilled));
+
+    m_spill.clear();
+    m_spilled.store(false, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SESSION_RECEIVE_QUEUE_H
+#define MANGOS_SESSION_RECEIVE_QUEUE_H
+
+#include "Common.h"
+#include "Util/SPSCQueue.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+class WorldPacket;
+
+// Incoming packets of a session, pushed by its socket and popped by the single thread updating the session
+// The consumer never locks unless the ring overflowed, then the surplus waits in a spill list so the order is kept
+class SessionReceiveQueue
+{
+    public:
+        explicit SessionReceiveQueue(size_t capacity);
+        ~SessionReceiveQueue();
+
+        void Push(std::unique_ptr<WorldPacket> packet);
+        bool Pop(std::unique_ptr<WorldPacket>& packet);
+        // next packet Pop would return, nullptr when empty, consumer only
+        WorldPacket* Front();
+
+        // packets are numbered in push order, the next popped packet is number GetPoppedCount()
+        uint64 GetPoppedCount() const { return m_popped.load(std::memory_order_acquire); }
+        uint64 GetPushedCount() const { return m_pushed.load(std::memory_order_acquire); }
+
+        // packets waiting, may be read from any thread for diagnostics
+        size_t GetDepth() const
+        {
+            uint64 const popped = m_popped.load(std::memory_order_acquire);
+            return size_t(m_pushed.load(std::memory_order_acquire) - popped);
+        }
+
+    private:
+        bool TakeSpill();
+
+        SPSCQueue<std::unique_ptr<WorldPacket>> m_ring;
+
+        std::mutex m_producerLock;
+        std::deque<std::unique_ptr<WorldPacket>> m_spill;
+        std::atomic<bool> m_spilled;
+
+        // consumer only
+        std::deque<std::unique_ptr<WorldPacket>> m_drain;
+
+        std::atomic<uint64> m_pushed;
+        std::atomic<uint64> m_popped;
+};
+
+#endif
@@ -23,6 +23,9 @@
 #include "Util/ByteBuffer.h"
 #include "Server/Opcodes.h"
 #include <chrono>
+#include <type_traits>
+
+class ObjectGuid;
 
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
@@ -34,6 +37,18 @@ class WorldPacket : public ByteBuffer
         {
         }
         explicit WorldPacket(Opcodes opcode, size_t reservedSize = 200) : ByteBuffer(reservedSize), m_opcode(opcode) {}
+        WorldPacket(Opcodes opcode, size_t size, Resize) : ByteBuffer(size, Resize()), m_opcode(opcode) {}
+
+        // packet made of fixed size fields only, the buffer is reserved for exactly what is written
+        template <typename... Fields>
+        static WorldPacket Build(Opcodes opcode, Fields... fields)
+        {
+            static_assert(((std::is_arithmetic<Fields>::value || std::is_same<Fields, ObjectGuid>::value) && ...), "WorldPacket::Build only takes fixed size fields");
+
+            WorldPacket packet(opcode, (sizeof(Fields) + ... + 0));
+            (packet << ... << fields);
+            return packet;
+        }
 
         void Initialize(Opcodes opcode, size_t reservedSize = 200)
         {
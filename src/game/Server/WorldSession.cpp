@@ -62,7 +62,7 @@
 static bool MapSessionFilterHelper(WorldSession* session, OpcodeHandler const& opHandle)
 {
     // we do not process thread-unsafe packets
-    if (opHandle.packetProcessing == PROCESS_THREADUNSAFE)
+    if (opHandle.packetProcessing == PROCESS_THREADUNSAFE || opHandle.packetProcessing == PROCESS_THREADSAFE_SESSION)
         return false;
 
     // we do not process not loggined player packets
@@ -105,7 +105,9 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetStorageLocaleIndexFor(locale)),
     m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_sessionState(WORLD_SESSION_STATE_CREATED),
     m_timeSyncClockDeltaQueue(6), m_timeSyncClockDelta(0), m_pendingTimeSyncRequests(), m_timeSyncNextCounter(0),
-    m_requestSocket(nullptr), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter) {}
+    m_requestSocket(nullptr), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter),
+    m_recvQueue(sWorld.getConfig(CONFIG_UINT32_NETWORK_RECEIVE_QUEUE_SIZE)), m_recvQueueMap(sWorld.getConfig(CONFIG_UINT32_NETWORK_RECEIVE_QUEUE_SIZE)),
+    m_discardMovementBefore(0) {}
 
 /// WorldSession destructor
 WorldSession::~WorldSession()
@@ -282,35 +284,15 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
     }
 
     if (opHandle.packetProcessing == PROCESS_MAP_THREAD)
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        m_recvQueueMap.push_back(std::move(new_packet));
-    }
+        m_recvQueueMap.Push(std::move(new_packet));
     else
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        m_recvQueue.push_back(std::move(new_packet));
-    }
+        m_recvQueue.Push(std::move(new_packet));
 }
 
 void WorldSession::DeleteMovementPackets()
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-    for (auto itr = m_recvQueueMap.begin(); itr != m_recvQueueMap.end();)
-    {
-        switch ((*itr)->GetOpcode())
-        {
-            case MSG_MOVE_SET_FACING:
-            case MSG_MOVE_HEARTBEAT:
-            {
-                itr = m_recvQueueMap.erase(itr);
-                break;
-            }
-            default:
-                ++itr;
-                break;
-        }
-    }
+    // the map queue is only read by its consumer, UpdateMap drops the movement packets queued until now
+    m_discardMovementBefore = m_recvQueueMap.GetPushedCount();
 }
 
 /// Logging helper for unexpected opcodes
@@ -359,12 +341,6 @@ bool WorldSession::Update(uint32 /*diff*/)
 {
     GetMessager().Execute(this);
 
-    std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        std::swap(recvQueueCopy, m_recvQueue);
-    }
-
     if (m_socket && !m_socket->IsClosed() && m_anticheat)
     {
         auto const now = WorldTimer::getMSTime();
@@ -373,82 +349,15 @@ bool WorldSession::Update(uint32 /*diff*/)
     }
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
-    /// not process packets if socket already closed
-    while (m_socket && !m_socket->IsClosed() && !recvQueueCopy.empty())
+    /// packets received while this batch is handled wait for the next update
+    std::unique_ptr<WorldPacket> packet;
+    for (size_t batch = m_recvQueue.GetDepth(); batch > 0 && m_recvQueue.Pop(packet); --batch)
     {
-        // sLog.outError("MOEP: %s (0x%.4X)", packet->GetOpcodeName(), packet->GetOpcode());
-
-        auto const packet = std::move(recvQueueCopy.front());
-        recvQueueCopy.pop_front();
-
-        OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
-        switch (opHandle.status)
-        {
-            case STATUS_LOGGEDIN:
-                if (!_player)
-                {
-                    // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
-                    if (!m_playerRecentlyLogout)
-                        LogUnexpectedOpcode(*packet, "the player has not logged in yet");
-                }
-                else if (_player->IsInWorld())
-                    ExecuteOpcode(opHandle, *packet);
-
-                // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
-
-#if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
-                if (_player && _player->GetPlayerbotMgr())
-                    _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(*packet);
-#endif
-                break;
-            case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT:
-                if (!_player && !m_playerRecentlyLogout)
-                {
-                    LogUnexpectedOpcode(*packet, "the player has not logged in yet and not recently logout");
-                }
-                else
-                    // not expected _player or must checked in packet hanlder
-                    ExecuteOpcode(opHandle, *packet);
-                break;
-            case STATUS_TRANSFER:
-                if (!_player)
-                    LogUnexpectedOpcode(*packet, "the player has not logged in yet");
-                else if (_player->IsInWorld())
-                    LogUnexpectedOpcode(*packet, "the player is still in world");
-                else
-                    ExecuteOpcode(opHandle, *packet);
-                break;
-            case STATUS_AUTHED:
-                // prevent cheating with skip queue wait
-                if (m_inQueue && packet->GetOpcode() != CMSG_WARDEN_DATA)
-                {
-                    LogUnexpectedOpcode(*packet, "the player not pass queue yet");
-                    break;
-                }
-
-                // single from authed time opcodes send in to after logout time
-                // and before other STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT opcodes.
-                if (packet->GetOpcode() != CMSG_SET_ACTIVE_VOICE_CHANNEL)
-                    m_playerRecentlyLogout = false;
+        /// not process packets if socket already closed
+        if (!m_socket || m_socket->IsClosed())
+            continue;
 
-                ExecuteOpcode(opHandle, *packet);
-                break;
-            case STATUS_NEVER:
-                sLog.outError("SESSION: received not allowed opcode %s (0x%.4X)",
-                              packet->GetOpcodeName(),
-                              packet->GetOpcode());
-                break;
-            case STATUS_UNHANDLED:
-                DEBUG_LOG("SESSION: received not handled opcode %s (0x%.4X)",
-                          packet->GetOpcodeName(),
-                          packet->GetOpcode());
-                break;
-            default:
-                sLog.outError("SESSION: received wrong-status-req opcode %s (0x%.4X)",
-                              packet->GetOpcodeName(),
-                              packet->GetOpcode());
-                break;
-        }
+        ProcessPacket(*packet);
     }
 
 #ifdef BUILD_DEPRECATED_PLAYERBOT
@@ -463,10 +372,9 @@ bool WorldSession::Update(uint32 /*diff*/)
         {
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
-            while(!pBotWorldSession->m_recvQueue.empty())
+            std::unique_ptr<WorldPacket> botpacket;
+            while (pBotWorldSession->m_recvQueue.Pop(botpacket))
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
 
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
@@ -489,7 +397,6 @@ bool WorldSession::Update(uint32 /*diff*/)
         {
             if (m_requestSocket)
             {
-                std::lock_guard<std::mutex> guard(m_recvQueueLock);
                 if (!IsOffline())
                     SetOffline();
 
@@ -569,19 +476,23 @@ bool WorldSession::Update(uint32 /*diff*/)
 
 void WorldSession::UpdateMap(uint32 diff)
 {
-    std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
+    // packets received while this batch is handled wait for the next update
+    std::unique_ptr<WorldPacket> packet;
+    for (size_t batch = m_recvQueueMap.GetDepth(); batch > 0; --batch)
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        std::swap(recvQueueMapCopy, m_recvQueueMap);
-    }
+        uint64 const index = m_recvQueueMap.GetPoppedCount();
+        if (!m_recvQueueMap.Pop(packet))
+            break;
 
-    while (m_socket && !m_socket->IsClosed() && recvQueueMapCopy.size())
-    {
-        auto const packet = std::move(recvQueueMapCopy.front());
-        recvQueueMapCopy.pop_front();
+        if (!m_socket || m_socket->IsClosed())
+            continue;
+
+        // queued before the player was teleported
+        if (index < m_discardMovementBefore && (packet->GetOpcode() == MSG_MOVE_SET_FACING || packet->GetOpcode() == MSG_MOVE_HEARTBEAT))
+            continue;
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
-        
+
         if (opHandle.status == STATUS_LOGGEDIN)
         {
             ExecuteOpcode(opHandle, *packet);
@@ -592,13 +503,12 @@ void WorldSession::UpdateMap(uint32 diff)
 #ifdef ENABLE_PLAYERBOTS
 void WorldSession::HandleBotPackets()
 {
-    while (!m_recvQueue.empty())
+    std::unique_ptr<WorldPacket> packet;
+    while (m_recvQueue.Pop(packet))
     {
         if (_player)
             _player->SetCanDelayTeleport(true);
 
-        auto const packet = std::move(m_recvQueue.front());
-        m_recvQueue.pop_front();
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
         (this->*opHandle.handler)(*packet);
 
@@ -1219,6 +1129,106 @@ void WorldSession::SendRedirectClient(std::string& ip, uint16 port) const
     SendPacket(pkt);
 }
 
+bool WorldSession::CanUpdateInParallel() const
+{
+#if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
+    // the bot manager sees every packet of its master and is not thread-safe
+    if (_player && _player->GetPlayerbotMgr())
+        return false;
+#endif
+
+    return true;
+}
+
+void WorldSession::UpdateParallel()
+{
+    if (!m_socket || m_socket->IsClosed())
+        return;
+
+    // stop at the first packet that needs the world thread, the ones after it have to wait for it to keep their order
+    while (WorldPacket* packet = m_recvQueue.Front())
+    {
+        if (opcodeTable[packet->GetOpcode()].packetProcessing != PROCESS_THREADSAFE_SESSION)
+            break;
+
+        std::unique_ptr<WorldPacket> threadSafePacket;
+        m_recvQueue.Pop(threadSafePacket);
+        ProcessPacket(*threadSafePacket);
+    }
+}
+
+void WorldSession::ProcessPacket(WorldPacket& packet)
+{
+    OpcodeHandler const& opHandle = opcodeTable[packet.GetOpcode()];
+    switch (opHandle.status)
+    {
+        case STATUS_LOGGEDIN:
+            if (!_player)
+            {
+                // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
+                if (!m_playerRecentlyLogout)
+                    LogUnexpectedOpcode(packet, "the player has not logged in yet");
+            }
+            else if (_player->IsInWorld())
+                ExecuteOpcode(opHandle, packet);
+
+            // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
+
+#if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
+            if (_player && _player->GetPlayerbotMgr())
+                _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(packet);
+#endif
+            break;
+        case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT:
+            if (!_player && !m_playerRecentlyLogout)
+            {
+                LogUnexpectedOpcode(packet, "the player has not logged in yet and not recently logout");
+            }
+            else
+                // not expected _player or must checked in packet hanlder
+                ExecuteOpcode(opHandle, packet);
+            break;
+        case STATUS_TRANSFER:
+            if (!_player)
+                LogUnexpectedOpcode(packet, "the player has not logged in yet");
+            else if (_player->IsInWorld())
+                LogUnexpectedOpcode(packet, "the player is still in world");
+            else
+                ExecuteOpcode(opHandle, packet);
+            break;
+        case STATUS_AUTHED:
+            // prevent cheating with skip queue wait
+            if (m_inQueue && packet.GetOpcode() != CMSG_WARDEN_DATA)
+            {
+                LogUnexpectedOpcode(packet, "the player not pass queue yet");
+                break;
+            }
+
+            // single from authed time opcodes send in to after logout time
+            // and before other STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT opcodes.
+            if (packet.GetOpcode() != CMSG_SET_ACTIVE_VOICE_CHANNEL)
+                m_playerRecentlyLogout = false;
+
+            ExecuteOpcode(opHandle, packet);
+            break;
+        case STATUS_NEVER:
+            sLog.outError("SESSION: received not allowed opcode %s (0x%.4X)",
+                          packet.GetOpcodeName(),
+                          packet.GetOpcode());
+            break;
+        case STATUS_UNHANDLED:
+            DEBUG_LOG("SESSION: received not handled opcode %s (0x%.4X)",
+                      packet.GetOpcodeName(),
+                      packet.GetOpcode());
+            break;
+        default:
+            sLog.outError("SESSION: received wrong-status-req opcode %s (0x%.4X)",
+                          packet.GetOpcodeName(),
+                          packet.GetOpcode());
+            break;
+    }
+}
+
 void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet)
 {
     // need prevent do internal far teleports in handlers because some handlers do lot steps
@@ -1320,9 +1330,7 @@ void WorldSession::ResetTimeSync()
 
 void WorldSession::SendTimeSync()
 {
-    WorldPacket data(SMSG_TIME_SYNC_REQ, 4);
-    data << uint32(m_timeSyncNextCounter);
-    SendPacket(data);
+    SendPacket(WorldPacket::Build(SMSG_TIME_SYNC_REQ, uint32(m_timeSyncNextCounter)));
 
     m_pendingTimeSyncRequests[m_timeSyncNextCounter] = WorldTimer::getMSTime();
 
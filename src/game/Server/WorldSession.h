@@ -30,6 +30,7 @@
 #include "AuctionHouse/AuctionHouseMgr.h"
 #include "Entities/Item.h"
 #include "Server/WorldSocket.h"
+#include "Server/SessionReceiveQueue.h"
 #include "Multithreading/Messager.h"
 #include "LFG/LFGDefines.h"
 #include "BattleGround/BattleGroundDefines.h"
@@ -360,8 +361,15 @@ class WorldSession
 
         void DeleteMovementPackets();
 
+        // packets received but not handled yet, for diagnostics
+        size_t GetReceiveQueueDepth() const { return m_recvQueue.GetDepth(); }
+        size_t GetMapReceiveQueueDepth() const { return m_recvQueueMap.GetDepth(); }
+
         bool Update(uint32 diff);
         void UpdateMap(uint32 diff);
+        // handles the leading PROCESS_THREADSAFE_SESSION packets, may run concurrently with other sessions doing the same
+        void UpdateParallel();
+        bool CanUpdateInParallel() const;
 
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position) const;
@@ -1037,6 +1045,7 @@ class WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo, Unit* mover, bool unroot) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
+        void ProcessPacket(WorldPacket& packet);
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
 
         // logging helper
@@ -1103,10 +1112,10 @@ class WorldSession
         bool m_isRecruiter;
 
         // Thread safety mechanisms
-        std::mutex m_recvQueueLock;
-        std::mutex m_recvQueueMapLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        SessionReceiveQueue m_recvQueue;
+        SessionReceiveQueue m_recvQueueMap;
+        // map queue packets numbered below this are dropped when they are movement
+        std::atomic<uint64> m_discardMovementBefore;
 
         Messager<WorldSession> m_messager;
 
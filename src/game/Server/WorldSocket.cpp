@@ -24,6 +24,7 @@
 #include "Server/WorldPacket.h"
 #include "Globals/SharedDefines.h"
 #include "Util/ByteBuffer.h"
+#include "Util/BufferPool.h"
 #include "Server/Opcodes.h"
 #include "Server/PacketLog.h"
 #include "Database/DatabaseEnv.h"
@@ -35,6 +36,7 @@
 #include "Anticheat/Anticheat.hpp"
 
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include "World/WorldState.h"
@@ -119,10 +121,17 @@ std::deque<uint32> WorldSocket::GetIncOpcodeHistory()
 }
 
 WorldSocket::WorldSocket(boost::asio::io_context& context) : AsyncSocket(context), m_lastPingTime(std::chrono::system_clock::time_point::min()), m_overSpeedPings(0),
-    m_session(nullptr), m_seed(urand()), m_loggingPackets(false)
+    m_session(nullptr), m_seed(urand()), m_writeStrand(boost::asio::make_strand(context)), m_flushScheduled(false), m_writeInProgress(false),
+    m_loggingPackets(false)
 {
 }
 
+WorldSocket::~WorldSocket()
+{
+    while (OutgoingPacket* packet = m_sendQueue.Dequeue())
+        BufferPool::Deallocate(packet, sizeof(OutgoingPacket) + packet->size);
+}
+
 void WorldSocket::SendPacket(const WorldPacket& pct)
 {
     if (IsClosed())
@@ -134,33 +143,100 @@ void WorldSocket::SendPacket(const WorldPacket& pct)
     // Dump outgoing packet.
     sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct.GetOpcode(), pct.GetOpcodeName(), pct, false);
 
-    // encrypt thread unsafe due to being executed from map contexts frequently - TODO: move to post service context in future
-    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+    // framing and encryption happen on the network thread, the caller only copies the contents into a pooled node
+    OutgoingPacket* packet = new (BufferPool::Allocate(sizeof(OutgoingPacket) + pct.size())) OutgoingPacket();
+    packet->size = uint32(pct.size());
+    packet->opcode = pct.GetOpcode();
+    if (pct.size() > 0)
+        std::memcpy(packet->contents(), pct.contents(), pct.size());
 
-    ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
-    m_crypt.EncryptSend(static_cast<uint8*>(header.header), header.headerSize());
+    m_sendQueue.Enqueue(packet);
 
-    uint32 opcode = pct.GetOpcode();
+    if (!m_flushScheduled.exchange(true))
+    {
+        auto self(shared_from_this());
+        boost::asio::post(m_writeStrand, [self]() { self->FlushSendQueue(); });
+    }
+}
 
-    m_opcodeHistoryOut.push_front(uint32(opcode));
-    if (m_opcodeHistoryOut.size() > 50)
-        m_opcodeHistoryOut.resize(30);
+void WorldSocket::FlushSendQueue()
+{
+    // packets enqueued from now on need another flush
+    m_flushScheduled.exchange(false);
 
-    if (pct.size() > 0)
+    while (OutgoingPacket* packet = m_sendQueue.Dequeue())
     {
-        // allocate array for full message
-        std::shared_ptr<std::vector<char>> fullMessage = std::make_shared<std::vector<char>>(header.headerSize() + pct.size());
-        std::memcpy(fullMessage->data(), header.data(), header.headerSize()); // copy header
-        std::memcpy((fullMessage->data() + header.headerSize()), reinterpret_cast<const char*>(pct.contents()), pct.size()); // copy packet
-        auto self(shared_from_this());
-        Write(fullMessage->data(), fullMessage->size(), [self, fullMessage](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+        if (!IsClosed())
+        {
+            // thread safe due to only being called from the write strand, in the order the packets were sent
+            ServerPktHeader header(packet->size + 2, packet->opcode);
+            m_crypt.EncryptSend(static_cast<uint8*>(header.header), header.headerSize());
+
+            {
+                std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+                m_opcodeHistoryOut.push_front(uint32(packet->opcode));
+                if (m_opcodeHistoryOut.size() > 50)
+                    m_opcodeHistoryOut.resize(30);
+            }
+
+            // output buffers are only held while there is something to write, see StartWrite
+            if (!m_outgoingQueued.capacity())
+                m_outgoingQueued.reserve(sWorld.getConfig(CONFIG_UINT32_NETWORK_OUT_UBUFF));
+
+            // packets sent while a write is in progress go out together with the next one
+            m_outgoingQueued.insert(m_outgoingQueued.end(), header.data(), header.data() + header.headerSize());
+            if (packet->size > 0)
+                m_outgoingQueued.insert(m_outgoingQueued.end(), reinterpret_cast<const char*>(packet->contents()), reinterpret_cast<const char*>(packet->contents()) + packet->size);
+        }
+
+        BufferPool::Deallocate(packet, sizeof(OutgoingPacket) + packet->size);
     }
-    else
+
+    if (IsClosed())
+        return;
+
+    if (m_outgoingQueued.size() > sWorld.getConfig(CONFIG_UINT32_NETWORK_OUT_HIGH_WATER_MARK))
     {
-        std::shared_ptr<ServerPktHeader> sharedHeader = std::make_shared<ServerPktHeader>(header);
-        auto self(shared_from_this());
-        Write(sharedHeader->data(), sharedHeader->headerSize(), [self, sharedHeader](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+        sLog.outError("WorldSocket::FlushSendQueue: client %s does not keep up with its output (" SIZEFMTD " bytes queued), disconnecting.",
+            GetRemoteAddress().c_str(), m_outgoingQueued.size());
+        OutgoingBuffer().swap(m_outgoingQueued);
+        Close();
+        return;
     }
+
+    if (!m_writeInProgress && !m_outgoingQueued.empty())
+        StartWrite();
+}
+
+void WorldSocket::StartWrite()
+{
+    m_outgoingInFlight.clear();
+    std::swap(m_outgoingInFlight, m_outgoingQueued);
+    m_writeInProgress = true;
+
+    auto self(shared_from_this());
+    Write(m_outgoingInFlight.data(), m_outgoingInFlight.size(), [self](const boost::system::error_code& error, std::size_t /*written*/)
+    {
+        boost::asio::post(self->m_writeStrand, [self, error]()
+        {
+            self->m_writeInProgress = false;
+            if (error)
+            {
+                self->Close();
+                return;
+            }
+
+            if (!self->m_outgoingQueued.empty() && !self->IsClosed())
+            {
+                self->StartWrite();
+                return;
+            }
+
+            // drained, both buffers go back to the pool until the next packet
+            OutgoingBuffer().swap(self->m_outgoingInFlight);
+            OutgoingBuffer().swap(self->m_outgoingQueued);
+        });
+    });
 }
 
 bool WorldSocket::OnOpen()
@@ -185,10 +261,8 @@ bool WorldSocket::OnOpen()
 
 bool WorldSocket::ProcessIncomingData()
 {
-    std::shared_ptr<ClientPktHeader> header = std::make_shared<ClientPktHeader>();
-
     auto self(shared_from_this());
-    Read((char*)header.get(), sizeof(ClientPktHeader), [self, header](const boost::system::error_code& error, std::size_t /*read*/) -> void
+    Read(reinterpret_cast<char*>(&m_incomingHeader), sizeof(ClientPktHeader), [self](const boost::system::error_code& error, std::size_t /*read*/) -> void
     {
         if (error)
         {
@@ -196,24 +270,27 @@ bool WorldSocket::ProcessIncomingData()
             return;
         }
 
+        ClientPktHeader& header = self->m_incomingHeader;
+
         // thread safe due to always being called from service context
-        self->m_crypt.DecryptRecv((uint8*)header.get(), sizeof(ClientPktHeader));
+        self->m_crypt.DecryptRecv(reinterpret_cast<uint8*>(&header), sizeof(ClientPktHeader));
 
-        EndianConvertReverse(header->size);
-        EndianConvert(header->cmd);
+        EndianConvertReverse(header.size);
+        EndianConvert(header.cmd);
 
-        if ((header->size < 4) || (header->size > 0x2800) || (header->cmd >= NUM_MSG_TYPES))
+        if ((header.size < 4) || (header.size > 0x2800) || (header.cmd >= NUM_MSG_TYPES))
         {
-            sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", header->size, header->cmd);
+            sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", header.size, header.cmd);
             return;
         }
 
-        const Opcodes opcode = static_cast<Opcodes>(header->cmd);
+        const Opcodes opcode = static_cast<Opcodes>(header.cmd);
 
-        size_t packetSize = header->size - 4;
-        std::shared_ptr<std::vector<uint8>> packetBuffer = std::make_shared<std::vector<uint8>>(packetSize);
+        // the body is read straight into the packet's pooled buffer
+        size_t packetSize = header.size - 4;
+        self->m_incomingPacket = std::make_unique<WorldPacket>(opcode, packetSize, ByteBuffer::Resize());
 
-        self->Read(reinterpret_cast<char*>(packetBuffer->data()), packetBuffer->size(), [self, packetBuffer, opcode = opcode](const boost::system::error_code& error, std::size_t /*read*/) -> void
+        self->Read(reinterpret_cast<char*>(self->m_incomingPacket->contents()), packetSize, [self, opcode = opcode](const boost::system::error_code& error, std::size_t /*read*/) -> void
         {
             if (error)
             {
@@ -221,8 +298,7 @@ bool WorldSocket::ProcessIncomingData()
                 return;
             }
 
-            std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(opcode, packetBuffer->size());
-            pct->append(*packetBuffer.get());
+            std::unique_ptr<WorldPacket> pct = std::move(self->m_incomingPacket);
             if (sPacketLog->CanLogPacket() && self->IsLoggingPackets())
                 sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, self->GetRemoteIpAddress(), self->GetRemotePort());
 
@@ -693,9 +769,7 @@ bool WorldSocket::HandlePing(WorldPacket& recvPacket)
         }
     }
 
-    WorldPacket packet(SMSG_PONG, 4);
-    packet << ping;
-    SendPacket(packet);
+    SendPacket(WorldPacket::Build(SMSG_PONG, ping));
 
     return true;
 }
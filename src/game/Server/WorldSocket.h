@@ -29,10 +29,14 @@
 #include "AuthCrypt.h"
 #include "Auth/BigNumber.h"
 #include "Network/AsyncSocket.hpp"
+#include "Util/MPSCQueue.h"
+#include "Util/BufferPool.h"
 
 #include <chrono>
+#include <atomic>
 #include <functional>
 #include <deque>
+#include <memory>
 
 class WorldPacket;
 class WorldSession;
@@ -109,6 +113,10 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         BigNumber m_s;
 
+        /// Packet being received, only one read is outstanding at any time
+        ClientPktHeader m_incomingHeader;
+        std::unique_ptr<WorldPacket> m_incomingPacket;
+
         /// process one incoming packet.
         virtual bool ProcessIncomingData() override;
 
@@ -120,6 +128,38 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         std::mutex m_worldSocketMutex;
 
+        /// Serializes everything on the output side, packets are framed and encrypted there in send order
+        boost::asio::strand<boost::asio::io_context::executor_type> m_writeStrand;
+
+        /// Opcode and contents of a sent packet, copied into one pooled block that is also its queue node
+        struct OutgoingPacket
+        {
+            std::atomic<OutgoingPacket*> m_queueNext;
+            uint32 size;
+            uint16 opcode;
+
+            uint8 const* contents() const { return reinterpret_cast<uint8 const*>(this + 1); }
+            uint8* contents() { return reinterpret_cast<uint8*>(this + 1); }
+        };
+
+        /// Packets sent from any thread, waiting to be framed on the write strand
+        MPSCQueue<OutgoingPacket> m_sendQueue;
+        std::atomic<bool> m_flushScheduled;
+
+        /// Outgoing data queued since the last write started, swapped with m_outgoingInFlight by StartWrite.
+        /// Only one write is outstanding at any time, both only used on the write strand and taken from
+        /// the buffer pool while output is pending
+        typedef std::vector<char, PooledAllocator<char>> OutgoingBuffer;
+        OutgoingBuffer m_outgoingQueued;
+        OutgoingBuffer m_outgoingInFlight;
+        bool m_writeInProgress;
+
+        /// Frame and encrypt the packets of m_sendQueue
+        void FlushSendQueue();
+
+        /// Write everything queued so far in one go
+        void StartWrite();
+
         std::deque<uint32> m_opcodeHistoryOut;
         std::deque<uint32> m_opcodeHistoryInc;
 
@@ -127,6 +167,7 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
     public:
         WorldSocket(boost::asio::io_context& context);
+        ~WorldSocket();
 
         // send a packet \o/
         void SendPacket(const WorldPacket& pct);
@@ -728,7 +728,7 @@ struct GlyphOfScourgeStrike : public SpellScript
         SpellEntry const* spellInfo = spell->GetTriggeredByAuraSpellInfo();
         Unit* target = spell->GetUnitTarget();
         auto& auras = target->GetAurasByType(SPELL_AURA_PERIODIC_DAMAGE);
-        for (auto& aura : auras)
+        for (auto aura : auras)
         {
             // your diseases
             if (aura->GetSpellProto()->Dispel == DISPEL_DISEASE &&
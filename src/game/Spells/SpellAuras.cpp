@@ -7105,7 +7105,7 @@ void Aura::HandleModCastingSpeed(bool apply, bool /*Real*/)
     {
         auto& auras = target->GetAurasByType(m_modifier.m_auraname);
         int32 max = 0;
-        for (auto& data : auras)
+        for (auto data : auras)
         {
             if (this != data && exclusiveAuras.find(data->GetId()) != exclusiveAuras.end() && max < data->GetAmount())
                 max = data->GetAmount();
@@ -7125,7 +7125,7 @@ void Aura::HandleModMeleeRangedSpeedPct(bool apply, bool /*Real*/)
     {
         auto& auras = target->GetAurasByType(m_modifier.m_auraname);
         int32 max = 0;
-        for (auto& data : auras)
+        for (auto data : auras)
         {
             if (this != data && exclusiveAuras.find(data->GetId()) != exclusiveAuras.end() && max < data->GetAmount())
                 max = data->GetAmount();
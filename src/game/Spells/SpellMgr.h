@@ -2508,6 +2508,17 @@ class SpellMgr
             return nullptr;
         }
 
+        uint32 GetSpellProcEventGeneration() const { return m_spellProcEventGeneration; }
+
+        // proc flags auras of the spell react to, the spell_proc_event flags replace the dbc ones when set
+        uint32 GetSpellProcFlags(SpellEntry const* spellInfo) const
+        {
+            SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+            if (spellProcEvent && spellProcEvent->procFlags)
+                return spellProcEvent->procFlags;
+            return spellInfo->procFlags;
+        }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
@@ -2809,6 +2820,7 @@ class SpellMgr
         SpellElixirMap     mSpellElixirs;
         SpellThreatMap     mSpellThreatMap;
         SpellProcEventMap  mSpellProcEventMap;
+        uint32             m_spellProcEventGeneration;      // bumped every time mSpellProcEventMap is loaded
         SpellProcItemEnchantMap mSpellProcItemEnchantMap;
         SkillLineAbilityMap mSkillLineAbilityMapBySpellId;
         SkillLineAbilityMap mSkillLineAbilityMapBySkillId;
@@ -539,15 +539,20 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 
     ProcTriggeredVector procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
-    // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    RebuildProcHoldersIfReloaded();
+
+    // Fill procTriggered list, holders whose proc flags miss the event would fail IsTriggeredAtSpellProcEvent without side effects
+    for (size_t i = 0; i < m_procHolders.size(); ++i)
     {
-        SpellAuraHolder* holder = itr->second;
+        if (!(m_procHolders[i].procFlags & execData.procFlags))
+            continue;
+
+        SpellAuraHolder* holder = m_procHolders[i].holder;
         // skip deleted auras (possible at recursive triggered call
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
-        ProcTriggeredData procTriggeredData(nullptr, itr->second);
+        ProcTriggeredData procTriggeredData(nullptr, holder);
 
         SpellProcEventTriggerCheck result = IsTriggeredAtSpellProcEvent(execData, holder, procTriggeredData.spellProcEvent, procTriggeredData.canProc);
         if (holder->GetSpellProto()->HasAttribute(SPELL_ATTR_PROC_FAILURE_BURNS_CHARGE) &&
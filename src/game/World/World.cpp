@@ -46,6 +46,7 @@
 #include "Loot/LootMgr.h"
 #include "Entities/ItemEnchantmentMgr.h"
 #include "Maps/MapManager.h"
+#include "Maps/MapWorkers.h"
 #include "DBScripts/ScriptMgr.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "AI/CreatureAIRegistry.h"
@@ -81,6 +82,7 @@
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
+ #include "Util/BufferPool.h"
 #endif
 
 #ifdef ENABLE_PLAYERBOTS
@@ -128,6 +130,11 @@ World::World() : mail_timer(0), mail_timer_expires(0), m_NextDailyQuestReset(0),
     m_maxActiveSessionCount = 0;
     m_maxQueuedSessionCount = 0;
 
+    m_characterSaves = 0;
+    m_characterSaveStatements = 0;
+    m_characterSaveSkippedStatements = 0;
+    m_characterSaveSkippedBytes = 0;
+
     m_defaultDbcLocale = DEFAULT_LOCALE;
     m_availableDbcLocaleMask = 0;
 
@@ -176,6 +183,8 @@ void World::CleanupsBeforeStop()
 #endif
     KickAll(true);                                   // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
+    if (m_sessionUpdater.activated())
+        m_sessionUpdater.deactivate();
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
     sMapMgr.UnloadAll();                             // unload all grids (including locked in memory)
 }
@@ -515,6 +524,8 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD, "Compression.Threshold", 100);
+    setConfig(CONFIG_BOOL_COMPRESSION_ADAPTIVE, "Compression.Adaptive", false);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -667,6 +678,13 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_NUM_SESSION_THREADS, "SessionUpdate.Threads", 2);
+    setConfig(CONFIG_BOOL_MAP_ADAPTIVE_TICK, "MapUpdate.Adaptive.Enabled", false);
+    setConfigMin(CONFIG_UINT32_MAP_IDLE_INTERVAL, "MapUpdate.Adaptive.IdleInterval", 500, MIN_MAP_UPDATE_DELAY);
+    setConfigMin(CONFIG_UINT32_MAP_QUIET_INTERVAL, "MapUpdate.Adaptive.QuietInterval", 100, MIN_MAP_UPDATE_DELAY);
+    setConfig(CONFIG_BOOL_MAP_ASYNC_CLIENT_UPDATES, "MapUpdate.AsyncClientUpdates", true);
+    setConfig(CONFIG_UINT32_MAP_UPDATE_DATA_SHARD_PLAYERS, "MapUpdate.ClientUpdateShards.MinPlayers", 100);
+    setConfig(CONFIG_UINT32_NUM_MAP_UPDATE_DATA_SHARD_THREADS, "MapUpdate.ClientUpdateShards.Threads", 2);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -796,6 +814,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_UINT32_NETWORK_OUT_UBUFF, "Network.OutUBuff", 65536);
+    setConfigMin(CONFIG_UINT32_NETWORK_OUT_HIGH_WATER_MARK, "Network.OutHighWaterMark", 8 * 1024 * 1024, 1024 * 1024);
+    setConfigMinMax(CONFIG_UINT32_NETWORK_RECEIVE_QUEUE_SIZE, "Network.ReceiveQueueSize", 256, 16, 65536);
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
@@ -1498,6 +1519,7 @@ void World::SetInitialWorldSettings()
     // Update "uptime" table based on configuration entry in minutes.
     m_timers[WUPDATE_CORPSES].SetInterval(20 * MINUTE * IN_MILLISECONDS);
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY * IN_MILLISECONDS); // check for chars to delete every day
+    m_timers[WUPDATE_SAVE_STATS].SetInterval(getConfig(CONFIG_UINT32_INTERVAL_SAVE)); // each player saves once per interval
     m_timers[WUPDATE_RAID_BROWSER].SetInterval(IN_MILLISECONDS);
 
 #ifdef BUILD_AHBOT
@@ -1528,6 +1550,9 @@ void World::SetInitialWorldSettings()
     sMapMgr.Initialize();
     sLog.outString();
 
+    if (uint32 sessionThreads = getConfig(CONFIG_UINT32_NUM_SESSION_THREADS))
+        m_sessionUpdater.activate(sessionThreads);
+
     ///- Initialize Battlegrounds
     sLog.outString("Starting BattleGround System");
     sBattleGroundMgr.CreateInitialBattleGrounds();
@@ -1823,6 +1848,18 @@ void World::Update(uint32 diff)
         sObjectAccessor.RemoveOldCorpses();
     }
 
+    ///- Keep the character save statistics of the autosave interval that passed
+    if (m_timers[WUPDATE_SAVE_STATS].Passed())
+    {
+        m_timers[WUPDATE_SAVE_STATS].Reset();
+
+        std::lock_guard<std::mutex> guard(m_lastCharacterSavesLock);
+        m_lastCharacterSaves.saves = m_characterSaves.exchange(0);
+        m_lastCharacterSaves.statements = m_characterSaveStatements.exchange(0);
+        m_lastCharacterSaves.skippedStatements = m_characterSaveSkippedStatements.exchange(0);
+        m_lastCharacterSaves.skippedBytes = m_characterSaveSkippedBytes.exchange(0);
+    }
+
     ///- Process Game events when necessary
     if (m_timers[WUPDATE_EVENTS].Passed())
     {
@@ -2319,6 +2356,30 @@ void World::ShutdownCancel()
     DEBUG_LOG("Server %s cancelled.", (m_ShutdownMask & SHUTDOWN_MASK_RESTART ? "restart" : "shutdown"));
 }
 
+// Handles the thread-safe packets of a range of sessions, see WorldSession::UpdateParallel
+class SessionUpdateWorker : public Worker
+{
+    public:
+        SessionUpdateWorker(std::vector<WorldSession*> const& sessions, size_t begin, size_t end, MapUpdater& updater) :
+            Worker(updater), m_sessions(sessions), m_begin(begin), m_end(end)
+        {}
+
+        void execute() override
+        {
+            for (size_t i = m_begin; i < m_end; ++i)
+                m_sessions[i]->UpdateParallel();
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        std::vector<WorldSession*> const& m_sessions;
+        size_t m_begin;
+        size_t m_end;
+};
+
+static constexpr size_t SESSIONS_PER_UPDATE_WORKER = 64;
+
 void World::UpdateSessions(uint32 diff)
 {
     ///- Add new sessions
@@ -2333,6 +2394,28 @@ void World::UpdateSessions(uint32 diff)
             AddSession_(session);
     }
 
+    ///- Handle the thread-safe packets waiting at the front of the receive queues in parallel
+    if (m_sessionUpdater.activated())
+    {
+        m_parallelSessions.clear();
+        for (auto const& session : m_sessions)
+            if (session.second->GetReceiveQueueDepth() && session.second->CanUpdateInParallel())
+                m_parallelSessions.push_back(session.second);
+
+        // the world thread takes the last chunk itself
+        size_t const chunkCount = (m_parallelSessions.size() + SESSIONS_PER_UPDATE_WORKER - 1) / SESSIONS_PER_UPDATE_WORKER;
+        for (size_t i = 1; i < chunkCount; ++i)
+            m_sessionUpdater.schedule_update(new SessionUpdateWorker(m_parallelSessions, (i - 1) * SESSIONS_PER_UPDATE_WORKER, i * SESSIONS_PER_UPDATE_WORKER, m_sessionUpdater));
+
+        if (chunkCount)
+        {
+            for (size_t i = (chunkCount - 1) * SESSIONS_PER_UPDATE_WORKER; i < m_parallelSessions.size(); ++i)
+                m_parallelSessions[i]->UpdateParallel();
+
+            m_sessionUpdater.wait();
+        }
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(); itr != m_sessions.end();)
     {
@@ -2704,6 +2787,30 @@ void World::SetOnlinePlayer(Team team, uint8 race, uint8 plClass, bool apply)
     }
 }
 
+void World::AddCharacterSave(CharacterSaveStats const& save)
+{
+    m_characterSaves += save.saves;
+    m_characterSaveStatements += save.statements;
+    m_characterSaveSkippedStatements += save.skippedStatements;
+    m_characterSaveSkippedBytes += save.skippedBytes;
+}
+
+CharacterSaveStats World::GetCurrentCharacterSaves() const
+{
+    CharacterSaveStats saves;
+    saves.saves = m_characterSaves;
+    saves.statements = m_characterSaveStatements;
+    saves.skippedStatements = m_characterSaveSkippedStatements;
+    saves.skippedBytes = m_characterSaveSkippedBytes;
+    return saves;
+}
+
+CharacterSaveStats World::GetLastCharacterSaves() const
+{
+    std::lock_guard<std::mutex> guard(m_lastCharacterSavesLock);
+    return m_lastCharacterSaves;
+}
+
 void World::LoadDBVersion()
 {
     auto queryResult = WorldDatabase.Query("SELECT version, creature_ai_version, cache_id FROM db_version LIMIT 1");
@@ -2959,6 +3066,42 @@ void World::GeneratePacketMetrics()
 
     metric::measurement meas_latency("world.metrics.latency");
     meas_latency.add_field("online", std::to_string(GetAverageLatency()));
+
+    size_t queuedPackets = 0, maxQueueDepth = 0, queuedMapPackets = 0, maxMapQueueDepth = 0;
+    ExecuteForAllSessions([&](WorldSession const& session)
+    {
+        queuedPackets += session.GetReceiveQueueDepth();
+        maxQueueDepth = std::max(maxQueueDepth, session.GetReceiveQueueDepth());
+        queuedMapPackets += session.GetMapReceiveQueueDepth();
+        maxMapQueueDepth = std::max(maxMapQueueDepth, session.GetMapReceiveQueueDepth());
+    });
+
+    metric::measurement meas_queues("world.metrics.receive_queues");
+    meas_queues.add_field("queued", std::to_string(queuedPackets));
+    meas_queues.add_field("max_depth", std::to_string(maxQueueDepth));
+    meas_queues.add_field("queued_map", std::to_string(queuedMapPackets));
+    meas_queues.add_field("max_depth_map", std::to_string(maxMapQueueDepth));
+
+    // counters are cumulative, allocations per player and second are derived from their rate
+    metric::measurement meas_buffers("world.metrics.buffers");
+    meas_buffers.add_field("requests", std::to_string(BufferPool::GetRequestCount()));
+    meas_buffers.add_field("allocations", std::to_string(BufferPool::GetUpstreamAllocationCount()));
+
+    metric::measurement meas_accessor("world.metrics.object_accessor");
+    meas_accessor.add_field("contended_locks", std::to_string(ObjectAccessor::GetLookupContentionCount()));
+
+    std::pair<char const*, DatabaseType*> const databases[] = { {"world", &WorldDatabase}, {"character", &CharacterDatabase}, {"login", &LoginDatabase}, {"logs", &LogsDatabase} };
+    for (auto const& database : databases)
+    {
+        // executed and latency are cumulative, the average latency is derived from their rates
+        Database::AsyncQueueStats stats = database.second->GetAsyncQueueStats();
+        metric::measurement meas_db("world.metrics.db_queues", { {"database", database.first} });
+        meas_db.add_field("queued", std::to_string(stats.queued));
+        meas_db.add_field("max_worker_queued", std::to_string(stats.maxWorkerQueued));
+        meas_db.add_field("executed", std::to_string(stats.executed));
+        meas_db.add_field("latency_us", std::to_string(stats.totalLatency));
+        meas_db.add_field("max_latency_us", std::to_string(stats.maxLatency));
+    }
 }
 
 uint32 World::GetAverageLatency() const
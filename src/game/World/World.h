@@ -33,6 +33,7 @@
 #include "LFG/LFG.h"
 #include "LFG/LFGQueue.h"
 #include "BattleGround/BattleGroundQueue.h"
+#include "Maps/MapUpdater.h"
 
 #include <set>
 #include <list>
@@ -91,13 +92,18 @@ enum WorldTimers
     WUPDATE_GROUPS      = 6,
     WUPDATE_RAID_BROWSER= 7,
     WUPDATE_METRICS     = 8, // not used if BUILD_METRICS is not set
-    WUPDATE_COUNT       = 9
+    WUPDATE_SAVE_STATS  = 9,
+    WUPDATE_COUNT       = 10
 };
 
 /// Configuration elements
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_THRESHOLD,
+    CONFIG_UINT32_NETWORK_OUT_UBUFF,
+    CONFIG_UINT32_NETWORK_OUT_HIGH_WATER_MARK,
+    CONFIG_UINT32_NETWORK_RECEIVE_QUEUE_SIZE,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
@@ -152,6 +158,11 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_NUM_SESSION_THREADS,
+    CONFIG_UINT32_MAP_IDLE_INTERVAL,
+    CONFIG_UINT32_MAP_QUIET_INTERVAL,
+    CONFIG_UINT32_MAP_UPDATE_DATA_SHARD_PLAYERS,
+    CONFIG_UINT32_NUM_MAP_UPDATE_DATA_SHARD_THREADS,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -419,6 +430,9 @@ enum eConfigBoolValues
     CONFIG_BOOL_PRELOAD_MMAP_TILES,
     CONFIG_BOOL_SPECIALS_ACTIVE,
     CONFIG_BOOL_REGEN_ZONE_AREA_ON_STARTUP,
+    CONFIG_BOOL_MAP_ADAPTIVE_TICK,
+    CONFIG_BOOL_MAP_ASYNC_CLIENT_UPDATES,
+    CONFIG_BOOL_COMPRESSION_ADAPTIVE,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -467,6 +481,15 @@ struct CliCommandHolder
     }
 };
 
+/// Statements of character saves, and those left out compared to rewriting every row
+struct CharacterSaveStats
+{
+    uint32 saves = 0;
+    uint32 statements = 0;
+    uint32 skippedStatements = 0;
+    uint64 skippedBytes = 0;                                // parameter bytes of the unchanged rows not written again
+};
+
 /// The World
 class World
 {
@@ -495,6 +518,10 @@ class World
         uint32 GetOnlineTeamPlayers(bool alliance) const { return m_onlineTeams[alliance]; }
         uint32 GetOnlineRacePlayers(uint8 race) const { return m_onlineRaces[race]; }
         uint32 GetOnlineClassPlayers(uint8 plClass) const { return m_onlineClasses[plClass]; }
+        // character saves, collected per autosave interval
+        void AddCharacterSave(CharacterSaveStats const& save); // threadsafe
+        CharacterSaveStats GetCurrentCharacterSaves() const;
+        CharacterSaveStats GetLastCharacterSaves() const;
 
         /// Get the active session server limit (or security level limitations)
         uint32 GetPlayerAmountLimit() const { return m_playerLimit >= 0 ? m_playerLimit : 0; }
@@ -775,6 +802,10 @@ class World
         std::mutex m_sessionAddQueueLock;
         std::deque<WorldSession*> m_sessionAddQueue;
 
+        // handles the thread-safe packets of the sessions in parallel, see WorldSession::UpdateParallel
+        MapUpdater m_sessionUpdater;
+        std::vector<WorldSession*> m_parallelSessions;
+
         // used versions
         std::string m_DBVersion;
         std::string m_CreatureEventAIVersion;
@@ -806,6 +837,13 @@ class World
         std::array<std::atomic<uint32>, 2> m_onlineTeams;
         std::array<std::atomic<uint32>, MAX_RACES> m_onlineRaces;
         std::array<std::atomic<uint32>, MAX_CLASSES> m_onlineClasses;
+        // character save logging
+        std::atomic<uint32> m_characterSaves;
+        std::atomic<uint32> m_characterSaveStatements;
+        std::atomic<uint32> m_characterSaveSkippedStatements;
+        std::atomic<uint64> m_characterSaveSkippedBytes;
+        CharacterSaveStats m_lastCharacterSaves;
+        mutable std::mutex m_lastCharacterSavesLock;
 
         GraveyardManager m_graveyardManager;
 
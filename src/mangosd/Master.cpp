@@ -41,11 +41,16 @@
 #include "Policies/Singleton.h"
 #include "Network/AsyncListener.hpp"
 #include "Network/AsyncSocket.hpp"
+#include "Network/NetworkContextPool.hpp"
 
 #include <boost/thread.hpp>
 
 #include <memory>
 
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
+
 #ifdef _WIN32
 #include "Platform/ServiceWin32.h"
 extern int m_ServiceStatus;
@@ -220,18 +225,31 @@ int Master::Run()
 
     {
         int32 networkThreadCount = sConfig.GetIntDefault("Network.Threads", 1);
-        if (networkThreadCount <= 0)
+        if (networkThreadCount < 0)
         {
-            sLog.outError("Invalid network thread workers setting in mangosd.conf. (%d) should be > 0", networkThreadCount);
+            sLog.outError("Invalid network thread workers setting in mangosd.conf. (%d) should be >= 0", networkThreadCount);
             networkThreadCount = 1;
         }
+        else if (networkThreadCount == 0)
+            networkThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
         std::string bindIp = sConfig.GetStringDefault("BindIP", "0.0.0.0");
         int32 port = int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD));
-        MaNGOS::AsyncListener<WorldSocket> listener(m_context, bindIp, port);
 
-        std::vector<std::thread> threads;
-        for (int32 i = 0; i < networkThreadCount; ++i)
-            threads.emplace_back([&]() { m_context.run(); });
+        // one io_context and thread per network thread, every socket stays on the context that accepted it
+        MaNGOS::NetworkContextPool networkPool(networkThreadCount);
+        std::vector<std::unique_ptr<MaNGOS::AsyncListener<WorldSocket>>> listeners;
+        if (networkPool.GetSize() > 1 && sConfig.GetBoolDefault("Network.ReusePort", true) && MaNGOS::NetworkContextPool::CanReusePort())
+        {
+            for (size_t i = 0; i < networkPool.GetSize(); ++i)
+                listeners.emplace_back(std::make_unique<MaNGOS::AsyncListener<WorldSocket>>(networkPool.GetContext(i), bindIp, port, true));
+        }
+        else
+            listeners.emplace_back(std::make_unique<MaNGOS::AsyncListener<WorldSocket>>(networkPool, bindIp, port));
+
+        networkPool.Start();
+        sLog.outString("Network started with %u thread(s) and %u acceptor(s) using %s", uint32(networkPool.GetSize()), uint32(listeners.size()),
+            MaNGOS::NetworkContextPool::GetBackendName());
 
         std::unique_ptr<MaNGOS::AsyncListener<RASocket>> raListener;
         std::string raBindIp = sConfig.GetStringDefault("Ra.IP", "0.0.0.0");
@@ -250,11 +268,26 @@ int Master::Run()
 
         // wait for shut down and then let things go out of scope to close them down
         while (!World::IsStopped())
+        {
             std::this_thread::sleep_for(std::chrono::seconds(1));
+#ifdef BUILD_METRICS
+            for (size_t i = 0; i < networkPool.GetSize(); ++i)
+            {
+                MaNGOS::NetworkStatistics const& statistics = *networkPool.GetContext(i).GetStatistics();
+                metric::measurement meas("network.context", { { "context", std::to_string(i) } });
+                meas.add_field("bytes_in", std::to_string(statistics.bytesIn.load()));
+                meas.add_field("bytes_out", std::to_string(statistics.bytesOut.load()));
+                meas.add_field("accepted", std::to_string(statistics.accepted.load()));
+                meas.add_field("connections", std::to_string(statistics.connections.load()));
+                meas.add_field("pending", std::to_string(statistics.pendingOperations.load()));
+            }
+#endif
+        }
 
         world_thread.wait();
 
-        m_context.stop();
+        // stop the network threads before the listeners go out of scope
+        networkPool.Stop();
 
         if (raEnable)
         {
@@ -262,8 +295,6 @@ int Master::Run()
             m_raThread.join();
         }
 
-        for (int32 i = 0; i < networkThreadCount; ++i)
-            threads[i].join();
     }
 
     ///- Stop freeze protection before shutdown tasks
@@ -362,6 +393,7 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -370,10 +402,10 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + nAsyncConnections);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
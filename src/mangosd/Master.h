@@ -44,7 +44,6 @@ class Master
 
         void clearOnlineAccounts();
 
-        boost::asio::io_context m_context;
         boost::asio::io_context m_raContext;
 };
 
@@ -24,6 +24,7 @@
 #include "Auth/HMACSHA1.h"
 #include "Auth/base32.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Config/Config.h"
 #include "Log/Log.h"
 #include "RealmList.h"
@@ -394,155 +395,178 @@ bool AuthSocket::_HandleLogonChallenge()
             ///- Normalize account name
             // utf8ToUpperOnlyLatin(_login); -- client already send account in expected form
 
-            // Escape the user input used in DB to avoid further SQL injection
-            // Memory will be freed on AuthSocket object destruction
-            self->_safelogin = self->_login;
-            LoginDatabase.escape_string(self->_safelogin);
-            self->_safelocale = self->m_locale;
-            LoginDatabase.escape_string(self->_safelocale);
-            LoginDatabase.escape_string(self->m_os);
-
             *pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
             *pkt << uint8(0x00);
 
             ///- Verify that this IP is not in the ip_banned table
-            // No SQL injection possible (paste the IP address as passed by the socket)
-            std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-                "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", self->GetRemoteAddress().c_str()));
+            static SqlStatementID selIpBanned;
+            SqlStatement stmt = LoginDatabase.CreateStatement(selIpBanned, "SELECT expires_at FROM ip_banned "
+                "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = ?");
+            stmt.addString(self->GetRemoteAddress());
+            self->AsyncQuery(stmt, [self, pkt](std::unique_ptr<QueryResult> ipBanned)
+            {
+                if (ipBanned)
+                {
+                    *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+                    BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
+                    self->SendLogonChallengeResult(pkt);
+                    return;
+                }
+
+                self->LoadLogonChallengeAccount(pkt);
+            });
+        });
+    });
+
+    return true;
+}
+
+void AuthSocket::LoadLogonChallengeAccount(std::shared_ptr<ByteBuffer> pkt)
+{
+    ///- Get the account details from the account table
+    static SqlStatementID selAccount;
+    SqlStatement stmt = LoginDatabase.CreateStatement(selAccount, "SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = ?");
+    stmt.addString(_login);
+    AsyncQuery(stmt, [self = shared_from_this(), pkt](std::unique_ptr<QueryResult> queryResult)
+    {
+        if (!queryResult)                                   // no account
+        {
+            *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
+            self->SendLogonChallengeResult(pkt);
+            return;
+        }
 
-            if (ip_banned_result)
+        Field* fields = queryResult->Fetch();
+
+        ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+        if (fields[1].GetUInt8() == 1)                      // if ip is locked
+        {
+            DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), fields[2].GetString());
+            DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
+            if (strcmp(fields[2].GetString(), self->GetRemoteAddress().c_str()))
             {
-                *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
+                DEBUG_LOG("[AuthChallenge] Account IP differs");
+                *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+                self->SendLogonChallengeResult(pkt);
+                return;
             }
-            else
+
+            DEBUG_LOG("[AuthChallenge] Account IP matches");
+        }
+        else
+            DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
+
+        std::string databaseV = fields[4].GetCppString();
+        std::string databaseS = fields[5].GetCppString();
+
+        if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
+        {
+            *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+            DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
+            self->SendLogonChallengeResult(pkt);
+            return;
+        }
+
+        DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+        self->_accountId = fields[0].GetUInt32();
+        self->_token = fields[6].GetCppString();
+
+        uint8 secLevel = fields[3].GetUInt8();
+        self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+        ///- If the account is banned, reject the logon attempt
+        static SqlStatementID selAccountBanned;
+        SqlStatement banStmt = LoginDatabase.CreateStatement(selAccountBanned, "SELECT banned_at,expires_at FROM account_banned WHERE "
+            "account_id = ? AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)");
+        banStmt.addUInt32(self->_accountId);
+        self->AsyncQuery(banStmt, [self, pkt, databaseS](std::unique_ptr<QueryResult> banresult)
+        {
+            if (banresult)
             {
-                ///- Get the account details from the account table
-                // No SQL injection (escaped user name)
-                auto queryResult = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", self->_safelogin.c_str());
-                if (queryResult)
+                if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
+                {
+                    *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
+                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
+                }
+                else
                 {
-                    Field* fields = queryResult->Fetch();
+                    *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
+                }
 
-                    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-                    bool locked = false;
-                    if (fields[1].GetUInt8() == 1)               // if ip is locked
-                    {
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), fields[2].GetString());
-                        DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
-                        if (strcmp(fields[2].GetString(), self->GetRemoteAddress().c_str()))
-                        {
-                            DEBUG_LOG("[AuthChallenge] Account IP differs");
-                            *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                            locked = true;
-                        }
-                        else
-                            DEBUG_LOG("[AuthChallenge] Account IP matches");
-                    }
-                    else
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
+                self->SendLogonChallengeResult(pkt);
+                return;
+            }
 
-                    std::string databaseV = fields[4].GetCppString();
-                    std::string databaseS = fields[5].GetCppString();
-                    bool broken = false;
+            BigNumber s;
+            s.SetHexStr(databaseS.c_str());
 
-                    if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
-                    {
-                        *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                        DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
-                        broken = true;
-                    }
+            self->srp.CalculateHostPublicEphemeral();
 
-                    if (!locked && !broken)
-                    {
-                        ///- If the account is banned, reject the logon attempt
-                        auto banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                            "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", fields[0].GetUInt32());
-                        if (banresult)
-                        {
-                            if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                            {
-                                *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
-                                BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
-                            }
-                            else
-                            {
-                                *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                                BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
-                            }
-                        }
-                        else
-                        {
-                            DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                            BigNumber s;
-                            s.SetHexStr(databaseS.c_str());
-
-                            self->srp.CalculateHostPublicEphemeral();
-
-                            ///- Fill the response packet with the result
-                            *pkt << uint8(AUTH_LOGON_SUCCESS);
-
-                            // B may be calculated < 32B so we force minimal length to 32B
-                            pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
-                            *pkt << uint8(1);
-                            pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
-                            *pkt << uint8(32);
-                            pkt->append(self->srp.GetPrime().AsByteArray(32));
-                            pkt->append(s.AsByteArray());// 32 bytes
-                            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-                            uint8 securityFlags = 0;
-
-                            self->_token = fields[6].GetCppString();
-                            if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
-                                securityFlags = SECURITY_FLAG_AUTHENTICATOR;
-
-                            if (!self->_token.empty() && self->_build <= 6141)
-                                securityFlags = SECURITY_FLAG_PIN;
-
-                            *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
-
-                            if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
-                            {
-                                uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
-                                EndianConvert(gridSeedPkt);
-                                self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
-                                self->m_promptPin = true;
-
-                                *pkt << gridSeedPkt;
-                                pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
-                            }
-
-                            if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
-                            {
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint64(0);
-                            }
-
-                            if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
-                                *pkt << uint8(1);
-
-                            uint8 secLevel = fields[3].GetUInt8();
-                            self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                            ///- All good, await client's proof
-                            self->_status = STATUS_LOGON_PROOF;
-                        }
-                    }
-                }
-                else                                                // no account
-                    *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
+            ///- Fill the response packet with the result
+            *pkt << uint8(AUTH_LOGON_SUCCESS);
+
+            // B may be calculated < 32B so we force minimal length to 32B
+            pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
+            *pkt << uint8(1);
+            pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
+            *pkt << uint8(32);
+            pkt->append(self->srp.GetPrime().AsByteArray(32));
+            pkt->append(s.AsByteArray());// 32 bytes
+            pkt->append(VersionChallenge.data(), VersionChallenge.size());
+            uint8 securityFlags = 0;
+
+            if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
+                securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+
+            if (!self->_token.empty() && self->_build <= 6141)
+                securityFlags = SECURITY_FLAG_PIN;
+
+            *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+
+            if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
+            {
+                uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
+                EndianConvert(gridSeedPkt);
+                self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
+                self->m_promptPin = true;
+
+                *pkt << gridSeedPkt;
+                pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
             }
 
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-            self->ProcessIncomingData();
+            if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
+            {
+                *pkt << uint8(0);
+                *pkt << uint8(0);
+                *pkt << uint8(0);
+                *pkt << uint8(0);
+                *pkt << uint64(0);
+            }
+
+            if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
+                *pkt << uint8(1);
+
+            ///- All good, await client's proof
+            self->_status = STATUS_LOGON_PROOF;
+
+            self->SendLogonChallengeResult(pkt);
         });
     });
+}
 
-    return true;
+void AuthSocket::SendLogonChallengeResult(std::shared_ptr<ByteBuffer> pkt)
+{
+    Write((const char*)pkt->contents(), pkt->size(), [self = shared_from_this(), pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+    ProcessIncomingData();
+}
+
+void AuthSocket::AsyncQuery(SqlStatement& stmt, std::function<void(std::unique_ptr<QueryResult>)>&& callback)
+{
+    // the socket waits for the result without holding its io thread, the callback runs on the executor of the socket again
+    if (!stmt.AsyncQuery(GetAsioSocket().get_executor(), std::move(callback)))
+        Close();
 }
 
 /// Logon Proof command handler
@@ -657,45 +681,64 @@ bool AuthSocket::_HandleLogonProof()
             uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
             if (MaxWrongPassCount > 0)
             {
-                // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-                LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", self->_safelogin.c_str());
+                self->CountFailedLogin(MaxWrongPassCount);
+                return;
+            }
 
-                if (auto loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", self->_safelogin.c_str()))
+            self->ProcessIncomingData();
+        }
+    });
+
+    return true;
+}
+
+void AuthSocket::CountFailedLogin(uint32 maxWrongPassCount)
+{
+    // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+    static SqlStatementID updFailedLogins;
+    SqlStatement stmt = LoginDatabase.CreateStatement(updFailedLogins, "UPDATE account SET failed_logins = failed_logins + 1 WHERE username = ?");
+    stmt.addString(_login);
+    AsyncQuery(stmt, [self = shared_from_this(), maxWrongPassCount](std::unique_ptr<QueryResult> /*result*/)
+    {
+        static SqlStatementID selFailedLogins;
+        SqlStatement selStmt = LoginDatabase.CreateStatement(selFailedLogins, "SELECT id, failed_logins FROM account WHERE username = ?");
+        selStmt.addString(self->_login);
+        self->AsyncQuery(selStmt, [self, maxWrongPassCount](std::unique_ptr<QueryResult> loginfail)
+        {
+            if (loginfail)
+            {
+                Field* fields = loginfail->Fetch();
+                uint32 failed_logins = fields[1].GetUInt32();
+
+                if (failed_logins >= maxWrongPassCount)
                 {
-                    Field* fields = loginfail->Fetch();
-                    uint32 failed_logins = fields[1].GetUInt32();
+                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
 
-                    if (failed_logins >= MaxWrongPassCount)
+                    if (WrongPassBanType)
                     {
-                        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                        if (WrongPassBanType)
-                        {
-                            uint32 acc_id = fields[0].GetUInt32();
-                            LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
-                                "VALUES ('%u'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                acc_id, WrongPassBanTime);
-                            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                self->_login.c_str(), WrongPassBanTime, failed_logins);
-                        }
-                        else
-                        {
-                            std::string current_ip = self->GetRemoteAddress();
-                            LoginDatabase.escape_string(current_ip);
-                            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban')",
-                                current_ip.c_str(), WrongPassBanTime);
-                            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                current_ip.c_str(), WrongPassBanTime, self->_login.c_str(), failed_logins);
-                        }
+                        uint32 acc_id = fields[0].GetUInt32();
+                        static SqlStatementID insAccountBanned;
+                        SqlStatement banStmt = LoginDatabase.CreateStatement(insAccountBanned, "INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
+                            "VALUES (?," _UNIXTIME_ "," _UNIXTIME_ "+?,'MaNGOS realmd','Failed login autoban',1)");
+                        banStmt.PExecute(acc_id, WrongPassBanTime);
+                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                            self->_login.c_str(), WrongPassBanTime, failed_logins);
+                    }
+                    else
+                    {
+                        static SqlStatementID insIpBanned;
+                        SqlStatement banStmt = LoginDatabase.CreateStatement(insIpBanned, "INSERT INTO ip_banned VALUES (?," _UNIXTIME_ "," _UNIXTIME_ "+?,'MaNGOS realmd','Failed login autoban')");
+                        banStmt.PExecute(self->GetRemoteAddress().c_str(), WrongPassBanTime);
+                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                            self->GetRemoteAddress().c_str(), WrongPassBanTime, self->_login.c_str(), failed_logins);
                     }
                 }
             }
+
             self->ProcessIncomingData();
-        }
+        });
     });
-
-    return true;
 }
 
 /// Reconnect Challenge command handler
@@ -744,38 +787,40 @@ bool AuthSocket::_HandleReconnectChallenge()
 
             self->_login = (const char*)body->userName;
 
-            self->_safelogin = self->_login;
-            LoginDatabase.escape_string(self->_safelogin);
-
             EndianConvert(body->build);
             self->_build = body->build;
 
-            auto queryResult = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", self->_safelogin.c_str());
-
-            // Stop if the account is not found
-            if (!queryResult)
+            static SqlStatementID selSessionKey;
+            SqlStatement stmt = LoginDatabase.CreateStatement(selSessionKey, "SELECT sessionkey, id FROM account WHERE username = ?");
+            stmt.addString(self->_login);
+            self->AsyncQuery(stmt, [self](std::unique_ptr<QueryResult> queryResult)
             {
-                sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
-                self->Close();
-                return;
-            }
+                // Stop if the account is not found
+                if (!queryResult)
+                {
+                    sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
+                    self->Close();
+                    return;
+                }
 
-            Field* fields = queryResult->Fetch();
-            self->srp.SetStrongSessionKey(fields[0].GetString());
+                Field* fields = queryResult->Fetch();
+                self->srp.SetStrongSessionKey(fields[0].GetString());
+                self->_accountId = fields[1].GetUInt32();
 
-            ///- All good, await client's proof
-            self->_status = STATUS_RECON_PROOF;
+                ///- All good, await client's proof
+                self->_status = STATUS_RECON_PROOF;
 
-            ///- Sending response
-            std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
-            *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
-            *pkt << (uint8)0x00;
-            self->_reconnectProof.SetRand(16 * 8);
-            pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
-            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+                ///- Sending response
+                std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+                *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
+                *pkt << (uint8)0x00;
+                self->_reconnectProof.SetRand(16 * 8);
+                pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
+                pkt->append(VersionChallenge.data(), VersionChallenge.size());
+                self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
 
-            self->ProcessIncomingData();
+                self->ProcessIncomingData();
+            });
         });
     });
 
@@ -852,186 +897,59 @@ bool AuthSocket::_HandleRealmList()
             return;
         }
 
-        // Get the user id (else close the connection)
-        // No SQL injection (escaped user name)
+        ///- Update realm list if need
+        sRealmList.UpdateIfNeed();
 
-        auto queryResult = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", self->_safelogin.c_str());
-        if (!queryResult)
+        AccountRealmInfo info;
+        if (sRealmList.GetAccountRealmInfo(self->_accountId, info))
         {
-            sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
-            self->Close();
+            self->SendRealmList(info);
             return;
         }
 
-        uint32 id = (*queryResult)[0].GetUInt32();
-        uint8 accountSecurityLevel = (*queryResult)[1].GetUInt8();
-
-        ///- Update realm list if need
-        sRealmList.UpdateIfNeed();
-
-        ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-        ByteBuffer pkt;
-        self->LoadRealmlist(pkt, id, accountSecurityLevel);
-
-        std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
-        *hdr << (uint8)CMD_REALM_LIST;
-        *hdr << (uint16)pkt.size();
-        hdr->append(pkt);
-
-        self->Write((const char*)hdr->contents(), hdr->size(), [self, hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-        self->ProcessIncomingData();
-    });
-
-    return true;
-}
-
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
-{
-    switch (_build)
-    {
-        case 5875:                                          // 1.12.1
-        case 6005:                                          // 1.12.2
-        case 6141:                                          // 1.12.3
+        // Get the security level and the characters on each realm of the account (else close the connection)
+        static SqlStatementID selRealmCharacters;
+        SqlStatement stmt = LoginDatabase.CreateStatement(selRealmCharacters, "SELECT gmlevel, realmid, numchars FROM account "
+            "LEFT JOIN realmcharacters ON acctid = id WHERE id = ?");
+        stmt.addUInt32(self->_accountId);
+        self->AsyncQuery(stmt, [self](std::unique_ptr<QueryResult> queryResult)
         {
-            pkt << uint32(0);                               // unused value
-            pkt << uint8(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
+            if (!queryResult)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                RealmFlags realmflags = i.second.realmflags;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
-                std::string name = i.first;
-                if (realmflags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    char buf[20];
-                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
-                    name += buf;
-                }
-
-                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
-                if (!ok_build || (i.second.allowedSecurityLevel > _accountSecurityLevel))
-                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
-
-                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(_build, RealmZone(i.second.timezone));
-
-                pkt << uint32(i.second.icon);              // realm type
-                pkt << uint8(realmflags);                   // realmflags
-                pkt << name;                                // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(categoryId);                   // realm category
-                pkt << uint8(0x00);                         // unk, may be realm number/id?
+                sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
+                self->Close();
+                return;
             }
 
-            pkt << uint16(0x0002);                          // unused value (why 2?)
-            break;
-        }
-
-        case 8606:                                          // 2.4.3
-        case 10505:                                         // 3.2.2a
-        case 11159:                                         // 3.3.0a
-        case 11403:                                         // 3.3.2
-        case 11723:                                         // 3.3.3a
-        case 12340:                                         // 3.3.5a
-        default:                                            // and later
-        {
-            pkt << uint32(0);                               // unused value
-            pkt << uint16(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
+            AccountRealmInfo info;
+            info.securityLevel = (*queryResult)[0].GetUInt8();
+            do
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                uint8 lock = (i.second.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
-
-                RealmFlags realmFlags = i.second.realmflags;
-
-                // Show offline state for unsupported client builds
-                if (!ok_build)
-                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
-
-                if (!buildInfo)
-                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
-
-                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(_build, RealmZone(i.second.timezone));
-
-                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
-                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
-                pkt << uint8(realmFlags);                   // see enum RealmFlags
-                pkt << i.first;                            // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(categoryId);                   // realm category (Cfg_Categories.dbc)
-                pkt << uint8(0x2C);                         // unk, may be realm number/id?
-
-                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    pkt << uint8(buildInfo->major_version);
-                    pkt << uint8(buildInfo->minor_version);
-                    pkt << uint8(buildInfo->bugfix_version);
-                    pkt << uint16(_build);
-                }
+                Field* fields = queryResult->Fetch();
+                if (uint32 realmId = fields[1].GetUInt32())
+                    info.characters[realmId] = fields[2].GetUInt8();
             }
+            while (queryResult->NextRow());
 
-            pkt << uint16(0x0010);                          // unused value (why 10?)
-            break;
-        }
-    }
+            sRealmList.SetAccountRealmInfo(self->_accountId, info);
+            self->SendRealmList(info);
+        });
+    });
+
+    return true;
 }
 
-uint8 AuthSocket::getEligibleRealmCount(uint8 accountSecurityLevel)
+void AuthSocket::SendRealmList(AccountRealmInfo const& info)
 {
-    uint8 size = 0;
-    for (const auto& i : sRealmList)
-        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
-            size++;
-
-    return size;
+    ///- Copy the prebuilt realm list and fill in the # of user characters in each realm
+    std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+    *pkt << (uint8)CMD_REALM_LIST;
+    *pkt << (uint16)0;                                      // size, set below
+    sRealmList.WriteRealmList(*pkt, _build, info, _accountSecurityLevel);
+    pkt->put<uint16>(1, uint16(pkt->size() - 3));
+
+    Write((const char*)pkt->contents(), pkt->size(), [self = shared_from_this(), pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+    ProcessIncomingData();
 }
 
 /// Resume patch transfer
@@ -1148,25 +1066,34 @@ void AuthSocket::verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLog
     BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
     ///- Update the sessionkey, current ip and login time and reset number of failed logins in the account table for this account
-    // No SQL injection (escaped user input) and IP address as received by socket
+    // The proof is only sent once the session key is stored, the world server reads it when the client connects there
     const char* K_hex = srp.GetStrongSessionKey().AsHexStr();
-    // Note: In case of heavy load, this sync query will be a heavy bottleneck
-    LoginDatabase.DirectPExecute("UPDATE account SET sessionkey = '%s', locale = '%s', failed_logins = 0, os = '%s', platform = '%s' WHERE username = '%s'", K_hex, _safelocale.c_str(), m_os.c_str(), m_platform.c_str(), _safelogin.c_str());
-    std::unique_ptr<QueryResult> loginfail(LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str()));
-    if (loginfail)
-        LoginDatabase.PExecute("INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES('%u','%s'," _NOW_ ",'%u')", loginfail->Fetch()[0].GetUInt32(), GetRemoteAddress().c_str(), LOGIN_TYPE_REALMD);
+    static SqlStatementID updSessionKey;
+    SqlStatement stmt = LoginDatabase.CreateStatement(updSessionKey, "UPDATE account SET sessionkey = ?, locale = ?, failed_logins = 0, os = ?, platform = ? WHERE username = ?");
+    stmt.addString(K_hex);
+    stmt.addString(m_locale);
+    stmt.addString(m_os);
+    stmt.addString(m_platform);
+    stmt.addString(_login);
     OPENSSL_free((void*)K_hex);
 
-    ///- Finish SRP6 and send the final result to the client
-    Sha1Hash sha;
-    srp.Finalize(sha);
+    AsyncQuery(stmt, [self = shared_from_this()](std::unique_ptr<QueryResult> /*result*/)
+    {
+        static SqlStatementID insLogon;
+        SqlStatement logonStmt = LoginDatabase.CreateStatement(insLogon, "INSERT INTO account_logons(accountId,ip,loginTime,loginSource) VALUES(?,?," _NOW_ ",?)");
+        logonStmt.PExecute(self->_accountId, self->GetRemoteAddress().c_str(), uint32(LOGIN_TYPE_REALMD));
 
-    SendProof(sha);
+        ///- Finish SRP6 and send the final result to the client
+        Sha1Hash sha;
+        self->srp.Finalize(sha);
 
-    ///- Set _status to authed!
-    _status = STATUS_AUTHED;
+        self->SendProof(sha);
 
-    ProcessIncomingData();
+        ///- Set _status to authed!
+        self->_status = STATUS_AUTHED;
+
+        self->ProcessIncomingData();
+    });
 }
 
 int32 AuthSocket::generateToken(char const* b32key)
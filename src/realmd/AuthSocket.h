@@ -28,16 +28,20 @@
 #include "Auth/CryptoHash.h"
 #include "Auth/SRP6.h"
 #include "Util/ByteBuffer.h"
+#include "RealmList.h"
 
 #include "Network/AsyncSocket.hpp"
 
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <memory>
 
 #define HMAC_RES_SIZE 20
 
 struct sAuthLogonProof_C;
+class QueryResult;
+class SqlStatement;
 struct sAuthLogonPinData_C;
 
 class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
@@ -50,12 +54,10 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         bool OnOpen() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void SendRealmList(AccountRealmInfo const& info);
         bool VerifyPinData(uint32 pin, const sAuthLogonPinData_C& clientData);
         int32 generateToken(char const* b32key);
 
-        uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
-
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -70,6 +72,12 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
 
     private:
         void verifyVersionAndFinalizeAuthentication(std::shared_ptr<sAuthLogonProof_C> lp);
+        void LoadLogonChallengeAccount(std::shared_ptr<ByteBuffer> pkt);
+        void SendLogonChallengeResult(std::shared_ptr<ByteBuffer> pkt);
+        void CountFailedLogin(uint32 maxWrongPassCount);
+
+        // runs the statement on a database worker and continues with callback on this socket, closes the socket when it could not be queued
+        void AsyncQuery(SqlStatement& stmt, std::function<void(std::unique_ptr<QueryResult>)>&& callback);
 
         enum eStatus
         {
@@ -87,13 +95,12 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         eStatus _status;
 
         std::string _login;
-        std::string _safelogin;
         std::string _token;
         std::string m_os;
         std::string m_platform;
         std::string m_locale;
-        std::string _safelocale;
         uint16 _build;
+        uint32 _accountId = 0;
         AccountTypes _accountSecurityLevel;
 
         BigNumber m_serverSecuritySalt;
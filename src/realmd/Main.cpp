@@ -222,7 +222,7 @@ int main(int argc, char* argv[])
     }
 
     // Get the list of realms for the server
-    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20));
+    sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20), sConfig.GetIntDefault("RealmListAccountCacheTime", 10));
     if (sRealmList.size() == 0)
     {
         sLog.outError("No valid realms specified.");
@@ -365,9 +365,10 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    int nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
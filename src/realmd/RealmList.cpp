@@ -100,7 +100,8 @@ uint8 GetRealmCategoryIdByBuildAndZone(uint16 _build, RealmZone _realmZone)
     return buildInfo ? RealmCategoryIdsByRealmZoneByMajorVersion[buildInfo->major_version][_realmZone] : _realmZone;
 }
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
+RealmList::RealmList() : m_snapshot(std::make_shared<RealmListSnapshot const>()), m_UpdateInterval(0), m_NextUpdateTime(time(nullptr)), m_accountCacheTime(0),
+    m_accountCachePruneTime(0)
 {
 }
 
@@ -111,18 +112,19 @@ RealmList& sRealmList
 }
 
 /// Load the realm list from the database
-void RealmList::Initialize(uint32 updateInterval)
+void RealmList::Initialize(uint32 updateInterval, uint32 accountCacheTime)
 {
     m_UpdateInterval = updateInterval;
+    m_accountCacheTime = accountCacheTime;
 
     ///- Get the content of the realmlist table in the database
     UpdateRealms(true);
 }
 
-void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
+void RealmList::UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
 {
     ///- Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    Realm& realm = realms[name];
 
     realm.m_ID       = ID;
     realm.icon       = icon;
@@ -161,13 +163,14 @@ void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::strin
 void RealmList::UpdateIfNeed()
 {
     // maybe disabled or updated recently
-    if (!m_UpdateInterval || m_NextUpdateTime > time(nullptr))
+    time_t now = time(nullptr);
+    time_t nextUpdateTime = m_NextUpdateTime;
+    if (!m_UpdateInterval || nextUpdateTime > now)
         return;
 
-    m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
-
-    // Clears Realm list
-    m_realms.clear();
+    // only one thread reloads, the others keep showing the current realms meanwhile
+    if (!m_NextUpdateTime.compare_exchange_strong(nextUpdateTime, now + m_UpdateInterval))
+        return;
 
     // Get the content of the realmlist table in the database
     UpdateRealms(false);
@@ -177,6 +180,9 @@ void RealmList::UpdateRealms(bool init)
 {
     DETAIL_LOG("Updating Realm List...");
 
+    std::shared_ptr<RealmListSnapshot> snapshot = std::make_shared<RealmListSnapshot>();
+    snapshot->version = m_snapshot.load()->version + 1;
+
     ////                                           0   1     2        3     4     5           6         7                     8           9
     auto queryResult = LoginDatabase.Query("SELECT id, name, address, port, icon, realmflags, timezone, allowedSecurityLevel, population, realmbuilds FROM realmlist WHERE (realmflags & 1) = 0 ORDER BY name");
 
@@ -204,7 +210,7 @@ void RealmList::UpdateRealms(bool init)
                 realmflags &= (REALM_FLAG_OFFLINE | REALM_FLAG_NEW_PLAYERS | REALM_FLAG_RECOMMENDED | REALM_FLAG_SPECIFYBUILD);
             }
 
-            UpdateRealm(
+            UpdateRealm(snapshot->realms,
                 Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
                 fields[4].GetUInt8(), RealmFlags(realmflags), fields[6].GetUInt8(),
                 (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR),
@@ -215,4 +221,233 @@ void RealmList::UpdateRealms(bool init)
         }
         while (queryResult->NextRow());
     }
+
+    ///- Prebuild the realm list of every client build a realm or realmd supports
+    std::set<uint16> builds;
+    for (int i = 0; ExpectedRealmdClientBuilds[i].build; ++i)
+        builds.insert(ExpectedRealmdClientBuilds[i].build);
+    for (auto const& realm : snapshot->realms)
+        builds.insert(realm.second.realmbuilds.begin(), realm.second.realmbuilds.end());
+
+    for (uint16 build : builds)
+        BuildPayload(snapshot->realms, build, snapshot->payloads[build]);
+
+    DETAIL_LOG("Realm list version %u with %u realms", snapshot->version, uint32(snapshot->realms.size()));
+    m_snapshot.store(std::move(snapshot));
+
+    // character counts may belong to realms that changed
+    std::lock_guard<std::mutex> guard(m_accountCacheLock);
+    m_accountCache.clear();
+}
+
+void RealmList::BuildPayload(RealmMap const& realms, uint16 build, RealmListPayload& payload)
+{
+    ByteBuffer& pkt = payload.data;
+
+    switch (build)
+    {
+        case 5875:                                          // 1.12.1
+        case 6005:                                          // 1.12.2
+        case 6141:                                          // 1.12.3
+        {
+            payload.vanilla = true;
+            payload.lockMask = REALM_FLAG_OFFLINE;          // 1.x clients not support locked state show
+
+            for (const auto& i : realms)
+            {
+                bool ok_build = i.second.realmbuilds.find(build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                RealmFlags realmflags = i.second.realmflags;
+
+                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
+                std::string name = i.first;
+                if (realmflags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    char buf[20];
+                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
+                    name += buf;
+                }
+
+                // Show offline state for unsupported client builds
+                if (!ok_build)
+                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
+
+                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(build, RealmZone(i.second.timezone));
+
+                RealmListPayload::Entry entry;
+                entry.realmId = i.second.m_ID;
+                entry.allowedSecurityLevel = i.second.allowedSecurityLevel;
+                entry.offset = pkt.wpos();
+
+                pkt << uint32(i.second.icon);              // realm type
+                entry.lockPos = pkt.wpos() - entry.offset;
+                pkt << uint8(realmflags);                   // realmflags
+                pkt << name;                                // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                entry.charactersPos = pkt.wpos() - entry.offset;
+                pkt << uint8(0);                            // characters of the account
+                pkt << uint8(categoryId);                   // realm category
+                pkt << uint8(0x00);                         // unk, may be realm number/id?
+
+                entry.size = pkt.wpos() - entry.offset;
+                payload.entries.push_back(entry);
+            }
+            break;
+        }
+
+        case 8606:                                          // 2.4.3
+        case 10505:                                         // 3.2.2a
+        case 11159:                                         // 3.3.0a
+        case 11403:                                         // 3.3.2
+        case 11723:                                         // 3.3.3a
+        case 12340:                                         // 3.3.5a
+        default:                                            // and later
+        {
+            payload.vanilla = false;
+            payload.lockMask = 0x01;
+
+            for (const auto& i : realms)
+            {
+                bool ok_build = i.second.realmbuilds.find(build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                RealmFlags realmFlags = i.second.realmflags;
+
+                // Show offline state for unsupported client builds
+                if (!ok_build)
+                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
+
+                uint8 categoryId = GetRealmCategoryIdByBuildAndZone(build, RealmZone(i.second.timezone));
+
+                RealmListPayload::Entry entry;
+                entry.realmId = i.second.m_ID;
+                entry.allowedSecurityLevel = i.second.allowedSecurityLevel;
+                entry.offset = pkt.wpos();
+
+                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
+                entry.lockPos = pkt.wpos() - entry.offset;
+                pkt << uint8(0);                            // flags, if 0x01, then realm locked
+                pkt << uint8(realmFlags);                   // see enum RealmFlags
+                pkt << i.first;                            // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                entry.charactersPos = pkt.wpos() - entry.offset;
+                pkt << uint8(0);                            // characters of the account
+                pkt << uint8(categoryId);                   // realm category (Cfg_Categories.dbc)
+                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+
+                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    pkt << uint8(buildInfo->major_version);
+                    pkt << uint8(buildInfo->minor_version);
+                    pkt << uint8(buildInfo->bugfix_version);
+                    pkt << uint16(build);
+                }
+
+                entry.size = pkt.wpos() - entry.offset;
+                payload.entries.push_back(entry);
+            }
+            break;
+        }
+    }
+}
+
+void RealmList::WriteRealmList(ByteBuffer& pkt, uint16 build, AccountRealmInfo const& account, AccountTypes accountSecurityLevel) const
+{
+    // the snapshot stays alive while it is read, even when an update replaces it meanwhile
+    std::shared_ptr<RealmListSnapshot const> snapshot = m_snapshot.load();
+
+    RealmListPayload const* payload;
+    RealmListPayload unlisted;
+    auto itr = snapshot->payloads.find(build);
+    if (itr != snapshot->payloads.end())
+        payload = &itr->second;
+    else
+    {
+        // builds above the highest known one are accepted, but no realm list is prebuilt for them
+        BuildPayload(snapshot->realms, build, unlisted);
+        payload = &unlisted;
+    }
+
+    uint32 eligibleCount = 0;
+    for (auto const& entry : payload->entries)
+        if (entry.allowedSecurityLevel <= account.securityLevel)
+            ++eligibleCount;
+
+    pkt << uint32(0);                                       // unused value
+    if (payload->vanilla)
+        pkt << uint8(eligibleCount);
+    else
+        pkt << uint16(eligibleCount);
+
+    for (auto const& entry : payload->entries)
+    {
+        // Don't display higher security realms for players.
+        if (!account.securityLevel && entry.allowedSecurityLevel > 0)
+            continue;
+
+        size_t pos = pkt.wpos();
+        pkt.append(payload->data.contents() + entry.offset, entry.size);
+
+        auto characters = account.characters.find(entry.realmId);
+        if (characters != account.characters.end())
+            pkt.put<uint8>(pos + entry.charactersPos, characters->second);
+
+        if (entry.allowedSecurityLevel > accountSecurityLevel)
+            pkt.put<uint8>(pos + entry.lockPos, payload->data.contents()[entry.offset + entry.lockPos] | payload->lockMask);
+    }
+
+    if (payload->vanilla)
+        pkt << uint16(0x0002);                              // unused value (why 2?)
+    else
+        pkt << uint16(0x0010);                              // unused value (why 10?)
+}
+
+bool RealmList::GetAccountRealmInfo(uint32 accountId, AccountRealmInfo& info)
+{
+    std::lock_guard<std::mutex> guard(m_accountCacheLock);
+    auto itr = m_accountCache.find(accountId);
+    if (itr == m_accountCache.end())
+        return false;
+
+    if (itr->second.expireTime <= time(nullptr))
+    {
+        m_accountCache.erase(itr);
+        return false;
+    }
+
+    info = itr->second.info;
+    return true;
+}
+
+void RealmList::SetAccountRealmInfo(uint32 accountId, AccountRealmInfo const& info)
+{
+    if (!m_accountCacheTime)
+        return;
+
+    time_t now = time(nullptr);
+    std::lock_guard<std::mutex> guard(m_accountCacheLock);
+
+    // realm updates may be disabled, so accounts that do not ask again are dropped here once expired
+    if (m_accountCachePruneTime <= now)
+    {
+        for (auto itr = m_accountCache.begin(); itr != m_accountCache.end();)
+        {
+            if (itr->second.expireTime <= now)
+                itr = m_accountCache.erase(itr);
+            else
+                ++itr;
+        }
+        m_accountCachePruneTime = now + m_accountCacheTime;
+    }
+
+    m_accountCache[accountId] = { info, now + m_accountCacheTime };
 }
@@ -24,7 +24,13 @@
 #define _REALMLIST_H
 
 #include "Common.h"
+#include "Util/ByteBuffer.h"
+
 #include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 struct RealmBuildInfo
 {
@@ -56,31 +62,85 @@ struct Realm
     RealmBuildInfo realmBuildInfo;                          // build info for show version in list
 };
 
+typedef std::unordered_map<uint32, uint8> RealmCharacterCounts; // realm id -> characters of the account
+
+/// Account data shown in the realm list
+struct AccountRealmInfo
+{
+    uint8 securityLevel;
+    RealmCharacterCounts characters;
+};
+
+typedef std::map<std::string, Realm> RealmMap;
+
+/// Realm list packet of one client build with every field filled but the ones of the account
+struct RealmListPayload
+{
+    struct Entry
+    {
+        uint32 realmId;
+        AccountTypes allowedSecurityLevel;
+        size_t offset;                                      // of the entry in data
+        size_t size;
+        size_t charactersPos;                               // of the character count, relative to offset
+        size_t lockPos;                                     // of the byte lockMask is set in for accounts not allowed to join
+    };
+
+    ByteBuffer data;
+    std::vector<Entry> entries;
+    uint8 lockMask;
+    bool vanilla;                                           // 1.x clients use another realm count size and footer
+};
+
+/// Realms loaded by one realm list update, never changed once published
+struct RealmListSnapshot
+{
+    uint32 version;
+    RealmMap realms;
+    std::map<uint16, RealmListPayload> payloads;            // by client build
+};
+
 /// Storage object for the list of realms on the server
 class RealmList
 {
     public:
-        typedef std::map<std::string, Realm> RealmMap;
-
         static RealmList& Instance();
 
         RealmList();
         ~RealmList() {}
 
-        void Initialize(uint32 updateInterval);
+        void Initialize(uint32 updateInterval, uint32 accountCacheTime);
 
         void UpdateIfNeed();
 
-        RealmMap::const_iterator begin() const { return m_realms.begin(); }
-        RealmMap::const_iterator end() const { return m_realms.end(); }
-        uint32 size() const { return m_realms.size(); }
+        uint32 size() const { return m_snapshot.load()->realms.size(); }
+
+        // appends the realm list shown to a client of build logged in with the account
+        void WriteRealmList(ByteBuffer& pkt, uint16 build, AccountRealmInfo const& account, AccountTypes accountSecurityLevel) const;
+
+        // account data is cached for a few seconds, clients request the realm list again and again while it is shown
+        bool GetAccountRealmInfo(uint32 accountId, AccountRealmInfo& info);
+        void SetAccountRealmInfo(uint32 accountId, AccountRealmInfo const& info);
     private:
         void UpdateRealms(bool init);
-        void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        static void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        static void BuildPayload(RealmMap const& realms, uint16 build, RealmListPayload& payload);
     private:
-        RealmMap m_realms;                                  ///< Internal map of realms
+        std::atomic<std::shared_ptr<RealmListSnapshot const>> m_snapshot; ///< Current realms, replaced as a whole on updates
         uint32   m_UpdateInterval;
-        time_t   m_NextUpdateTime;
+        std::atomic<time_t> m_NextUpdateTime;
+
+        struct CachedAccountRealmInfo
+        {
+            AccountRealmInfo info;
+            time_t expireTime;
+        };
+        typedef std::unordered_map<uint32, CachedAccountRealmInfo> AccountRealmInfoCache;
+
+        AccountRealmInfoCache m_accountCache;               ///< Realm list data by account id, cleared on realm updates
+        std::mutex m_accountCacheLock;
+        uint32   m_accountCacheTime;
+        time_t   m_accountCachePruneTime;                   ///< Next time expired entries are removed from the cache
 };
 
 #define sRealmList RealmList::Instance()
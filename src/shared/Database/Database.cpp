@@ -20,11 +20,16 @@
 #include "Config/Config.h"
 #include "Database/SqlOperations.h"
 
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
 #include <ctime>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <cstdarg>
+#include <thread>
 
 #define MIN_CONNECTION_POOL_SIZE 1
 #define MAX_CONNECTION_POOL_SIZE 16
@@ -44,6 +49,11 @@ void SqlConnection::FreePreparedStatements()
         delete m_holder[i];
 
     m_holder.clear();
+
+    for (auto& stmt : m_queryHolder)
+        delete stmt;
+
+    m_queryHolder.clear();
 }
 
 SqlPreparedStatement* SqlConnection::GetStmt(uint32 nIndex)
@@ -78,6 +88,21 @@ SqlPreparedStatement* SqlConnection::GetStmt(uint32 nIndex)
     return pStmt;
 }
 
+SqlPlainPreparedStatement* SqlConnection::GetQueryStmt(uint32 nIndex)
+{
+    if (m_queryHolder.size() <= nIndex)
+        m_queryHolder.resize(nIndex + 1, nullptr);
+
+    if (!m_queryHolder[nIndex])
+    {
+        std::string fmt = m_db.GetStmtString(nIndex);
+        MANGOS_ASSERT(fmt.length());
+        m_queryHolder[nIndex] = new SqlPlainPreparedStatement(fmt, *this);
+    }
+
+    return m_queryHolder[nIndex];
+}
+
 bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
 {
     if (nIndex == -1)
@@ -91,13 +116,40 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+std::unique_ptr<QueryResult> SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+        return nullptr;
+
+    SqlPlainPreparedStatement* pStmt = GetQueryStmt(nIndex);
+    pStmt->bind(id);
+
+    if (!pStmt->isQuery())
+    {
+        pStmt->execute();
+        return nullptr;
+    }
+
+    return pStmt->query();
+}
+
+//////////////////////////////////////////////////////////////////////////
+struct Database::QueryWorkers
+{
+    QueryWorkers() : work(boost::asio::make_work_guard(context)) {}
+
+    boost::asio::io_context context;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work;
+    std::vector<std::thread> threads;
+};
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -134,10 +186,21 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
-        return false;
+    // create and initialize connections for async requests
+    nAsyncConns = std::min(std::max(nAsyncConns, MIN_CONNECTION_POOL_SIZE), MAX_CONNECTION_POOL_SIZE);
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
+    }
+
+    m_pAsyncConn = m_pAsyncConnections[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -150,9 +213,11 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
+    for (auto& pAsyncConn : m_pAsyncConnections)
+        delete pAsyncConn;
 
     m_pResultQueue = nullptr;
+    m_pAsyncConnections.clear();
     m_pAsyncConn = nullptr;
 
     for (auto& m_pQueryConnection : m_pQueryConnections)
@@ -161,30 +226,150 @@ void Database::StopServer()
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, uint32 index)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, index);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
+    // New delay threads for delay execute, one per async connection
+    for (uint32 i = 0; i < m_pAsyncConnections.size(); ++i)
+        m_threadBodies.push_back(CreateDelayThread(m_pAsyncConnections[i], i));  // will deleted at m_delayThreads delete
+
+    for (auto threadBody : m_threadBodies)
+        m_delayThreads.push_back(new MaNGOS::Thread(threadBody));
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    {
+        std::lock_guard<std::mutex> guard(m_queryWorkersGuard);
+        if (m_queryWorkers)
+        {
+            // queued queries still run, their callbacks may be posted to executors no longer running
+            m_queryWorkers->work.reset();
+            for (auto& thread : m_queryWorkers->threads)
+                thread.join();
+            delete m_queryWorkers;
+            m_queryWorkers = nullptr;
+        }
+    }
+
+    if (m_threadBodies.empty() || m_delayThreads.empty()) return;
+
+    for (auto threadBody : m_threadBodies)
+        threadBody->Stop();                                 // Stop event
+
+    // wakes the workers waiting for their partner, they give up as they are no longer running
+    {
+        std::lock_guard<std::mutex> lock(m_orderGuard);
+        m_orderCondition.notify_all();
+    }
+
+    for (auto delayThread : m_delayThreads)
+        delayThread->wait();                                // Wait for flush to DB
+
+    // a worker may have stopped while waiting for its partner, what is left is executed here in the order it was queued
+    while (true)
+    {
+        SqlDelayThread* oldest = m_threadBodies[0];
+        for (auto threadBody : m_threadBodies)
+            if (threadBody->GetPendingSequence() < oldest->GetPendingSequence())
+                oldest = threadBody;
+
+        if (!oldest->ProcessNext())
+            break;
+    }
+
+    for (auto delayThread : m_delayThreads)
+        delete delayThread;                                 // This also deletes the thread bodies
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+bool Database::Delay(SqlOperation* operation, uint32 orderingKey /*= 0*/, uint32 secondOrderingKey /*= 0*/)
+{
+    // an operation with two keys on different workers is queued to the first one and the second one holds
+    // its place until it is executed, operations without key are barriers: every other worker holds their place
+    std::lock_guard<std::mutex> guard(m_delayGuard);
+    if (m_threadBodies.empty())
+    {
+        delete operation;
+        return false;
+    }
+
+    if (!orderingKey && m_threadBodies.size() > 1)
+    {
+        uint64 sequence = ++m_delaySequence;
+        for (size_t i = 1; i < m_threadBodies.size(); ++i)
+            m_threadBodies[i]->Delay(nullptr, sequence, m_threadBodies[0]);
+
+        return m_threadBodies[0]->Delay(operation, sequence, nullptr, true);
+    }
+
+    SqlDelayThread* worker = m_threadBodies[orderingKey % m_threadBodies.size()];
+    SqlDelayThread* partner = secondOrderingKey ? m_threadBodies[secondOrderingKey % m_threadBodies.size()] : nullptr;
+    if (partner == worker)
+        partner = nullptr;
+
+    uint64 sequence = ++m_delaySequence;
+    if (partner)
+        partner->Delay(nullptr, sequence, worker);
+
+    return worker->Delay(operation, sequence, partner);
+}
+
+bool Database::WaitForPartner(SqlDelayThread const& worker, SqlDelayThread const& partner, uint64 sequence, bool placeholder)
+{
+    // the operation runs once its place is reached on the partner, the place is held until the operation is executed
+    auto ready = [&]()
+    {
+        return placeholder ? partner.GetPendingSequence() > sequence : partner.GetPendingSequence() >= sequence;
+    };
+
+    if (ready())
+        return true;
+
+    std::unique_lock<std::mutex> lock(m_orderGuard);
+    m_orderCondition.wait(lock, [&]() { return ready() || !worker.IsRunning(); });
+    return ready();
+}
+
+bool Database::WaitForAllWorkers(SqlDelayThread const& worker, uint64 sequence)
+{
+    for (auto threadBody : m_threadBodies)
+        if (threadBody != &worker && !WaitForPartner(worker, *threadBody, sequence, false))
+            return false;
+
+    return true;
+}
+
+void Database::NotifyOperationExecuted()
+{
+    if (m_threadBodies.size() == 1)
+        return;
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = nullptr;
-    m_threadBody = nullptr;
+    // taken so a worker can not miss the notification between checking and waiting
+    { std::lock_guard<std::mutex> lock(m_orderGuard); }
+    m_orderCondition.notify_all();
+}
+
+Database::AsyncQueueStats Database::GetAsyncQueueStats()
+{
+    AsyncQueueStats stats = {};
+    for (auto threadBody : m_threadBodies)
+    {
+        stats.queued += threadBody->GetQueueDepth();
+        stats.maxWorkerQueued = std::max(stats.maxWorkerQueued, threadBody->GetQueueDepth());
+        stats.executed += threadBody->GetExecutedCount();
+        stats.totalLatency += threadBody->GetTotalLatency();
+        stats.maxLatency = std::max(stats.maxLatency, threadBody->ResetMaxLatency());
+    }
+    return stats;
 }
 
 void Database::ThreadStart()
@@ -229,8 +414,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (auto& pAsyncConn : m_pAsyncConnections)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(pAsyncConn);
         guard->Query(sql);
     }
 
@@ -340,7 +526,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        Delay(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -386,7 +572,7 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 orderingKey /*= 0*/, uint32 secondOrderingKey /*= 0*/)
 {
     if (!m_pAsyncConn)
         return false;
@@ -394,22 +580,29 @@ bool Database::BeginTransaction()
     MANGOS_ASSERT(!m_currentTransaction.get());   // if we will get a nested transaction request - we MUST fix code!!!
 
     if (!m_currentTransaction.get())
-        m_currentTransaction.reset(new SqlTransaction);
+        m_currentTransaction.reset(new SqlTransaction(orderingKey, secondOrderingKey));
 
     return m_currentTransaction.get() != nullptr;
 }
 
-bool Database::CommitTransaction()
+bool Database::CommitTransaction(SqlTransactionResult* result /*= nullptr*/)
 {
     if (!m_pAsyncConn || !m_currentTransaction.get())
         return false;
 
+    if (result)
+    {
+        *result = std::make_shared<std::atomic<SqlTransactionState>>(SQL_TRANSACTION_PENDING);
+        m_currentTransaction->SetResult(*result);
+    }
+
     // if async execution is not available
     if (!m_allowAsyncTransactions)
         return CommitTransactionDirect();
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_currentTransaction.release());
+    SqlTransaction* pTrans = m_currentTransaction.release();
+    Delay(pTrans, pTrans->GetOrderingKey(), pTrans->GetSecondOrderingKey());
     return true;
 }
 
@@ -563,7 +756,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        Delay(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -578,6 +771,43 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+bool Database::AsyncQueryStmt(const SqlStatementID& id, SqlStmtParameters* params, std::function<void(std::unique_ptr<QueryResult>)>&& callback)
+{
+    MANGOS_ASSERT(params);
+    std::unique_ptr<SqlStmtParameters> p(params);
+
+    std::lock_guard<std::mutex> guard(m_queryWorkersGuard);
+    if (!m_queryWorkers)
+    {
+        // workers only run along with the delay threads
+        if (m_threadBodies.empty())
+            return false;
+
+        m_queryWorkers = new QueryWorkers;
+        for (int i = 0; i < m_nQueryConnPoolSize; ++i)
+        {
+            m_queryWorkers->threads.emplace_back([this, &context = m_queryWorkers->context]()
+            {
+                ThreadStart();
+                context.run();
+                ThreadEnd();
+            });
+        }
+    }
+
+    boost::asio::post(m_queryWorkers->context, [this, nIndex = id.ID(), p = std::move(p), callback = std::move(callback)]()
+    {
+        std::unique_ptr<QueryResult> result;
+        {
+            SqlConnection::Lock _guard(getQueryConnection());
+            result = _guard->QueryStmt(nIndex, *p);
+        }
+        callback(std::move(result));
+    });
+
+    return true;
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
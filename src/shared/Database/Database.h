@@ -28,7 +28,10 @@
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 class SqlTransaction;
 class SqlResultQueue;
@@ -65,6 +68,8 @@ class SqlConnection
 
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        // result sets are read through the plain SQL request of the statement, its parameters are still bound typed and escaped
+        std::unique_ptr<QueryResult> QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         // SqlConnection object lock
         class Lock
@@ -88,6 +93,8 @@ class SqlConnection
         virtual SqlPreparedStatement* CreateStatement(const std::string& fmt);
         // allocate prepared statement and return statement ID
         SqlPreparedStatement* GetStmt(uint32 nIndex);
+        // allocate plain statement used to query result sets
+        SqlPlainPreparedStatement* GetQueryStmt(uint32 nIndex);
 
         Database& m_db;
 
@@ -99,6 +106,9 @@ class SqlConnection
 
         typedef std::vector<SqlPreparedStatement* > StmtHolder;
         StmtHolder m_holder;
+
+        typedef std::vector<SqlPlainPreparedStatement* > QueryStmtHolder;
+        QueryStmtHolder m_queryHolder;
 };
 
 class Database
@@ -106,10 +116,11 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        // nAsyncConns workers execute the async requests, each on its own connection
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads, requests still queued are executed in order
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -185,11 +196,17 @@ class Database
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
-        bool BeginTransaction();
-        bool CommitTransaction();
+        // transactions sharing an ordering key are executed in the order they were committed, possibly in parallel
+        // to those of other keys, the second key is for requests of two owners. Requests without key wait for
+        // everything queued before them and everything queued after them waits for them
+        bool BeginTransaction(uint32 orderingKey = 0, uint32 secondOrderingKey = 0);
+        // result, if given, tells once the transaction was executed whether it was committed
+        bool CommitTransaction(SqlTransactionResult* result = nullptr);
         bool RollbackTransaction();
         // for sync transaction execution
         bool CommitTransactionDirect();
+        // statements added so far to the transaction of this thread
+        size_t GetTransactionSize() const { return m_currentTransaction.get() ? m_currentTransaction->GetSize() : 0; }
 
         // PREPARED STATEMENT API
 
@@ -217,6 +234,19 @@ class Database
         // function to ping database connections
         void Ping();
 
+        // queue an operation to the async workers, see BeginTransaction for the ordering key
+        bool Delay(SqlOperation* operation, uint32 orderingKey = 0, uint32 secondOrderingKey = 0);
+
+        struct AsyncQueueStats
+        {
+            uint64 queued;                                  // operations waiting for or in execution
+            uint64 maxWorkerQueued;
+            uint64 executed;                                // cumulative
+            uint64 totalLatency;                            // cumulative microseconds from queueing to the end of execution
+            uint64 maxLatency;                              // highest latency since the previous call
+        };
+        AsyncQueueStats GetAsyncQueueStats();
+
         // set this to allow async transactions
         // you should call it explicitly after your server successfully started up
         // NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
@@ -225,7 +255,7 @@ class Database
     protected:
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
+            m_delaySequence(0), m_queryWorkers(nullptr), m_allowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -236,7 +266,7 @@ class Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, uint32 index);
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
         boost::thread_specific_ptr<SqlTransaction> m_currentTransaction;
@@ -245,14 +275,23 @@ class Database
 
         // round-robin connection selection
         SqlConnection* getQueryConnection();
-        // for now return one single connection for async requests
+        // connection of the first async worker, also used for direct execution
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
 
         friend class SqlStatement;
+        friend class SqlDelayThread;
+        // false when the worker was stopped before the operation it shares with the partner can go on
+        bool WaitForPartner(SqlDelayThread const& worker, SqlDelayThread const& partner, uint64 sequence, bool placeholder);
+        // false when the worker was stopped before every other worker reached the place held for the operation
+        bool WaitForAllWorkers(SqlDelayThread const& worker, uint64 sequence);
+        void NotifyOperationExecuted();
+
         // PREPARED STATEMENT API
         // query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        // runs the statement on a query worker, the workers are started on first use
+        bool AsyncQueryStmt(const SqlStatementID& id, SqlStmtParameters* params, std::function<void(std::unique_ptr<QueryResult>)>&& callback);
 
         // connection helper counters
         int m_nQueryConnPoolSize;                           // current size of query connection pool
@@ -262,12 +301,24 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
+        // one connection per async worker for transactions and async SELECTs
+        SqlConnectionContainer m_pAsyncConnections;
         SqlConnection* m_pAsyncConn;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;        ///< Delay sql executers (owned by m_delayThreads)
+        std::vector<MaNGOS::Thread*> m_delayThreads;        ///< Executer threads
+
+        // operations are numbered in the order they are queued, those of two workers wait for each other
+        std::mutex m_delayGuard;
+        uint64 m_delaySequence;
+        std::mutex m_orderGuard;
+        std::condition_variable m_orderCondition;
+
+        // threads running async statement queries, one per query connection
+        struct QueryWorkers;
+        QueryWorkers*       m_queryWorkers;
+        std::mutex m_queryWorkersGuard;
 
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
 
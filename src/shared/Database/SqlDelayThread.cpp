@@ -20,14 +20,15 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, uint32 index) : m_dbEngine(db), m_dbConnection(conn), m_index(index), m_running(true),
+    m_pendingSequence(NO_PENDING_SEQUENCE), m_queueDepth(0), m_executed(0), m_latencyTotal(0), m_latencyMax(0)
 {
 }
 
 SqlDelayThread::~SqlDelayThread()
 {
     // process all requests which might have been queued while thread was stopping
-    ProcessRequests();
+    while (ProcessNext()) {}
 }
 
 void SqlDelayThread::run()
@@ -51,7 +52,8 @@ void SqlDelayThread::run()
 
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        // the first worker pings the connections of all of them
+        if (!m_index && (loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
             m_dbEngine->Ping();
@@ -70,21 +72,83 @@ void SqlDelayThread::Stop()
     m_running = false;
 }
 
+bool SqlDelayThread::Delay(SqlOperation* sql, uint64 sequence, SqlDelayThread* partner /*= nullptr*/, bool barrier /*= false*/)
+{
+    std::lock_guard<std::mutex> guard(m_queueMutex);
+    // the executing operation stays queued until it is done, so an empty queue has nothing pending
+    if (m_sqlQueue.empty())
+        m_pendingSequence.store(sequence, std::memory_order_release);
+
+    m_sqlQueue.push({ std::unique_ptr<SqlOperation>(sql), sequence, partner, barrier, std::chrono::steady_clock::now() });
+    if (sql)
+        ++m_queueDepth;
+    return true;
+}
+
 void SqlDelayThread::ProcessRequests()
 {
-    std::queue<std::unique_ptr<SqlOperation>> sqlQueue;
+    // statements are not executed with the lock in place because this can result in a deadlock with the world thread
+    // which calls Database::ProcessResultQueue(), only this thread pops so the front stays valid without it
+    while (true)
+    {
+        QueuedOperation* op;
+        {
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            if (m_sqlQueue.empty())
+                return;
+
+            op = &m_sqlQueue.front();
+        }
+
+        // gives up once the thread is stopped, the database then executes what is left in order
+        if (op->barrier && !m_dbEngine->WaitForAllWorkers(*this, op->sequence))
+            return;
+
+        if (op->partner && !m_dbEngine->WaitForPartner(*this, *op->partner, op->sequence, !op->operation))
+            return;
+
+        Execute(*op);
+    }
+}
 
-    // we need to move the contents of the queue to a local copy because executing these statements with the
-    // lock in place can result in a deadlock with the world thread which calls Database::ProcessResultQueue()
+bool SqlDelayThread::ProcessNext()
+{
+    QueuedOperation* op;
     {
         std::lock_guard<std::mutex> guard(m_queueMutex);
-        sqlQueue = std::move(m_sqlQueue);
+        if (m_sqlQueue.empty())
+            return false;
+
+        op = &m_sqlQueue.front();
+    }
+
+    Execute(*op);
+    return true;
+}
+
+void SqlDelayThread::Execute(QueuedOperation& op)
+{
+    if (op.operation)
+    {
+        op.operation->Execute(m_dbConnection);
+
+        uint64 latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - op.queued).count();
+        m_latencyTotal.fetch_add(latency, std::memory_order_relaxed);
+        uint64 latencyMax = m_latencyMax.load(std::memory_order_relaxed);
+        while (latency > latencyMax && !m_latencyMax.compare_exchange_weak(latencyMax, latency, std::memory_order_relaxed)) {}
+        m_executed.fetch_add(1, std::memory_order_relaxed);
     }
 
-    while (!sqlQueue.empty())
+    std::unique_ptr<SqlOperation> executed;
     {
-        auto const s = std::move(sqlQueue.front());
-        sqlQueue.pop();
-        s->Execute(m_dbConnection);
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        if (op.operation)
+            --m_queueDepth;
+
+        executed = std::move(op.operation);
+        m_sqlQueue.pop();
+        m_pendingSequence.store(m_sqlQueue.empty() ? NO_PENDING_SEQUENCE : m_sqlQueue.front().sequence, std::memory_order_release);
     }
+
+    m_dbEngine->NotifyOperationExecuted();
 }
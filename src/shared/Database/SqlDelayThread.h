@@ -23,6 +23,8 @@
 #include "SqlOperations.h"
 
 #include <atomic>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -34,26 +36,53 @@ class SqlConnection;
 class SqlDelayThread : public MaNGOS::Runnable
 {
     private:
+        struct QueuedOperation
+        {
+            std::unique_ptr<SqlOperation> operation;        ///< Not set for the place held for the operation of another worker
+            uint64 sequence;                                ///< Position in the order the database received its operations
+            SqlDelayThread* partner;                        ///< Worker holding the place of, or executing, the same operation
+            bool barrier;                                   ///< Every other worker holds the place of the operation
+            std::chrono::steady_clock::time_point queued;
+        };
+
         std::mutex m_queueMutex;
-        std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
-        Database* m_dbEngine;                                   ///< Pointer to used Database engine
-        SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
+        std::queue<QueuedOperation> m_sqlQueue;             ///< Queue of SQL statements
+        Database* m_dbEngine;                               ///< Pointer to used Database engine
+        SqlConnection* m_dbConnection;                      ///< Pointer to DB connection
+        uint32 m_index;                                     ///< Position among the workers of the database, the first one pings
         std::atomic<bool> m_running;
 
-        // process all enqueued requests
+        std::atomic<uint64> m_pendingSequence;              ///< Sequence of the oldest operation not executed yet
+        std::atomic<uint64> m_queueDepth;
+        std::atomic<uint64> m_executed;
+        std::atomic<uint64> m_latencyTotal;                 ///< Microseconds from queueing to the end of execution
+        std::atomic<uint64> m_latencyMax;
+
+        // process all enqueued requests, shared ones wait for their partner worker and barriers for all other workers
         void ProcessRequests();
+        void Execute(QueuedOperation& op);
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        static constexpr uint64 NO_PENDING_SEQUENCE = std::numeric_limits<uint64>::max();
+
+        SqlDelayThread(Database* db, SqlConnection* conn, uint32 index);
         ~SqlDelayThread();
 
-        ///< Put sql statement to delay queue
-        bool Delay(SqlOperation* sql)
-        {
-            std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
-            return true;
-        }
+        ///< Put sql statement to delay queue, the database hands out the sequence. Without statement the worker
+        ///< holds the place of the partner's operation of that sequence until it is executed
+        bool Delay(SqlOperation* sql, uint64 sequence, SqlDelayThread* partner = nullptr, bool barrier = false);
+
+        // executes the oldest queued operation without waiting for other workers, false if nothing was queued
+        bool ProcessNext();
+
+        uint64 GetPendingSequence() const { return m_pendingSequence.load(std::memory_order_acquire); }
+        uint64 GetQueueDepth() const { return m_queueDepth.load(std::memory_order_relaxed); }
+        uint64 GetExecutedCount() const { return m_executed.load(std::memory_order_relaxed); }
+        uint64 GetTotalLatency() const { return m_latencyTotal.load(std::memory_order_relaxed); }
+        // highest latency since the last call
+        uint64 ResetMaxLatency() { return m_latencyMax.exchange(0, std::memory_order_relaxed); }
+
+        bool IsRunning() const { return m_running; }
 
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
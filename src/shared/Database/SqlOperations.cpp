@@ -44,6 +44,15 @@ SqlTransaction::~SqlTransaction()
 }
 
 bool SqlTransaction::Execute(SqlConnection* conn)
+{
+    bool success = ExecuteStatements(conn);
+    if (m_result)
+        m_result->store(success ? SQL_TRANSACTION_COMMITTED : SQL_TRANSACTION_FAILED, std::memory_order_release);
+
+    return success;
+}
+
+bool SqlTransaction::ExecuteStatements(SqlConnection* conn)
 {
     if (m_queue.empty())
         return true;
@@ -117,16 +126,15 @@ void SqlResultQueue::Add(MaNGOS::IQueryCallback* callback)
     m_queue.push(std::unique_ptr<MaNGOS::IQueryCallback>(callback));
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue)
 {
-    if (!callback || !thread || !queue)
+    if (!callback || !db || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
     SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
-    return true;
+    return db->Delay(holderEx, m_orderingKey);
 }
 
 bool SqlQueryHolder::SetQuery(size_t index, const char* sql)
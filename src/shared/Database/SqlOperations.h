@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Utilities/Callback.h"
 
+#include <atomic>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -54,16 +55,35 @@ class SqlPlainRequest : public SqlOperation
         bool Execute(SqlConnection* conn) override;
 };
 
+// outcome of a committed transaction, shared by the committer and the worker executing it
+enum SqlTransactionState
+{
+    SQL_TRANSACTION_PENDING,                                // not executed yet, or dropped without being executed
+    SQL_TRANSACTION_COMMITTED,
+    SQL_TRANSACTION_FAILED
+};
+
+typedef std::shared_ptr<std::atomic<SqlTransactionState>> SqlTransactionResult;
+
 class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue;
+        uint32 m_orderingKey;
+        uint32 m_secondOrderingKey;
+        SqlTransactionResult m_result;
+
+        bool ExecuteStatements(SqlConnection* conn);
 
     public:
-        SqlTransaction() {}
+        SqlTransaction(uint32 orderingKey = 0, uint32 secondOrderingKey = 0) : m_orderingKey(orderingKey), m_secondOrderingKey(secondOrderingKey) {}
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
+        uint32 GetOrderingKey() const { return m_orderingKey; }
+        uint32 GetSecondOrderingKey() const { return m_secondOrderingKey; }
+        void SetResult(SqlTransactionResult const& result) { m_result = result; }
+        size_t GetSize() const { return m_queue.size(); }
 
         bool Execute(SqlConnection* conn) override;
 };
@@ -122,15 +142,18 @@ class SqlQueryHolder
     private:
         typedef std::pair<const char*, std::unique_ptr<QueryResult>> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        uint32 m_orderingKey;
     public:
-        SqlQueryHolder() {}
+        SqlQueryHolder() : m_orderingKey(0) {}
         virtual ~SqlQueryHolder();
         bool SetQuery(size_t index, const char* sql);
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
         void SetSize(size_t size);
         std::unique_ptr<QueryResult> GetResult(size_t index);
         void SetResult(size_t index, std::unique_ptr<QueryResult> queryResult);
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        // the queries run after the transactions committed before with this key, see Database::BeginTransaction
+        void SetOrderingKey(uint32 orderingKey) { m_orderingKey = orderingKey; }
+        bool Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue);
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -21,6 +21,8 @@
 
 #include "Common.h"
 
+#include <functional>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 
@@ -203,6 +205,14 @@ class SqlStatement
         bool Execute();
         bool DirectExecute();
 
+        // run the statement on a database query worker, callback is called on that worker thread
+        // with the result set, nullptr when nothing was found or the statement is no query
+        bool AsyncQuery(std::function<void(std::unique_ptr<QueryResult>)>&& callback);
+        // same, but callback is posted to executor, e.g. the one of the socket waiting for the result
+        // implemented in DatabaseImpl.h
+        template<class Executor>
+        bool AsyncQuery(Executor const& executor, std::function<void(std::unique_ptr<QueryResult>)>&& callback);
+
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
         bool PExecute(ParamType1 param1)
@@ -320,6 +330,9 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
 
         virtual bool execute() override;
 
+        // run the bound request as query
+        std::unique_ptr<QueryResult> query();
+
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const;
 
@@ -19,34 +19,106 @@
 #ifndef MANGOS_MESSAGER_H
 #define MANGOS_MESSAGER_H
 
-#include <vector>
-#include <mutex>
-#include <functional>
+#include "Util/BufferPool.h"
 
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Messages posted from any thread and executed by the thread owning the object
+// Messages are linked into an intrusive lock free queue, their nodes come from the thread caches of the buffer pool
+// and closures up to INLINE_SIZE bytes are stored inside the node, so posting usually does not reach the allocator
 template <class T>
 class Messager
 {
     public:
-        void AddMessage(const std::function<void(T*)>& message)
+        Messager() : m_head(NewMessage()), m_tail(m_head.load(std::memory_order_relaxed)) {}
+        Messager(const Messager&) = delete;
+        Messager& operator=(const Messager&) = delete;
+
+        ~Messager()
         {
-            std::lock_guard<std::mutex> guard(m_messageMutex);
-            m_messageVector.push_back(message);
+            Message* next;
+            while ((next = m_tail->next.load(std::memory_order_acquire)))
+            {
+                next->destroy(*next);
+                DeleteMessage(m_tail);
+                m_tail = next;
+            }
+
+            DeleteMessage(m_tail);
         }
-        void Execute(T* object)
+
+        template <typename F>
+        void AddMessage(F&& message)
         {
-            std::vector<std::function<void(T*)>> messageVectorCopy;
+            typedef typename std::decay<F>::type Closure;
+
+            Message* node = NewMessage();
+            if constexpr (sizeof(Closure) <= INLINE_SIZE && alignof(Closure) <= alignof(std::max_align_t))
+            {
+                new (node->storage) Closure(std::forward<F>(message));
+                node->invoke = [](Message& msg, T* object) { (*std::launder(reinterpret_cast<Closure*>(msg.storage)))(object); };
+                node->destroy = [](Message& msg) { std::launder(reinterpret_cast<Closure*>(msg.storage))->~Closure(); };
+            }
+            else
             {
-                std::lock_guard<std::mutex> guard(m_messageMutex);
-                std::swap(m_messageVector, messageVectorCopy);
+                new (node->storage) Closure*(new Closure(std::forward<F>(message)));
+                node->invoke = [](Message& msg, T* object) { (**std::launder(reinterpret_cast<Closure**>(msg.storage)))(object); };
+                node->destroy = [](Message& msg) { delete *std::launder(reinterpret_cast<Closure**>(msg.storage)); };
             }
-            for (auto& message : messageVectorCopy)
-                message(object);
 
-            messageVectorCopy.clear();
+            Message* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // messages added while executing, including by the executed messages, wait for the next call
+        void Execute(T* object)
+        {
+            Message* const last = m_head.load(std::memory_order_acquire);
+            while (m_tail != last)
+            {
+                // a producer swapped the head but did not link its node yet, the rest waits for the next call
+                Message* next = m_tail->next.load(std::memory_order_acquire);
+                if (!next)
+                    break;
+
+                next->invoke(*next, object);
+                next->destroy(*next);
+
+                // the executed node is kept as the new stub until its successor is executed
+                DeleteMessage(m_tail);
+                m_tail = next;
+            }
         }
+
     private:
-        std::vector<std::function<void(T*)>> m_messageVector;
-        std::mutex m_messageMutex;  
+        // sized so a message node fills a 128 byte pool block
+        static constexpr size_t INLINE_SIZE = 96;
+
+        struct Message
+        {
+            std::atomic<Message*> next{nullptr};
+            void (*invoke)(Message&, T*) = nullptr;
+            void (*destroy)(Message&) = nullptr;
+            alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+        };
+
+        static Message* NewMessage()
+        {
+            return new (BufferPool::Allocate(sizeof(Message))) Message();
+        }
+
+        static void DeleteMessage(Message* message)
+        {
+            message->~Message();
+            BufferPool::Deallocate(message, sizeof(Message));
+        }
+
+        std::atomic<Message*> m_head;                       // last added message
+        Message* m_tail;                                    // already executed message, its successor is the next one
 };
 
-#endif
\ No newline at end of file
+#endif
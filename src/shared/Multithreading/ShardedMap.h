@@ -0,0 +1,116 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SHARDED_MAP_H
+#define MANGOS_SHARDED_MAP_H
+
+#include "Platform/Define.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+// Hash map split into shards, each behind its own reader writer lock
+// Lookups only share the lock of the shard their key falls into and writers block that one shard,
+// so threads looking up different keys, or the same key, do not wait on each other
+template <class Key, class Value, class Hash = std::hash<Key>>
+class ShardedMap
+{
+    public:
+        static constexpr size_t SHARD_COUNT = 16;
+
+        ShardedMap() = default;
+        ShardedMap(ShardedMap const&) = delete;
+        ShardedMap& operator=(ShardedMap const&) = delete;
+
+        void Insert(Key const& key, Value value)
+        {
+            Shard& shard = GetShard(key);
+            std::unique_lock<std::shared_mutex> guard(shard.lock, std::try_to_lock);
+            if (!guard.owns_lock())
+                Wait(shard, guard);
+            shard.map[key] = value;
+        }
+
+        void Remove(Key const& key)
+        {
+            Shard& shard = GetShard(key);
+            std::unique_lock<std::shared_mutex> guard(shard.lock, std::try_to_lock);
+            if (!guard.owns_lock())
+                Wait(shard, guard);
+            shard.map.erase(key);
+        }
+
+        // value initialized Value when the key is not found
+        Value Find(Key const& key) const
+        {
+            Shard& shard = GetShard(key);
+            std::shared_lock<std::shared_mutex> guard(shard.lock, std::try_to_lock);
+            if (!guard.owns_lock())
+                Wait(shard, guard);
+            auto itr = shard.map.find(key);
+            return itr != shard.map.end() ? itr->second : Value();
+        }
+
+        // one shard is locked at a time, the executor must not insert or remove
+        template <typename F>
+        void DoForAll(F&& executor) const
+        {
+            for (Shard& shard : m_shards)
+            {
+                std::shared_lock<std::shared_mutex> guard(shard.lock, std::try_to_lock);
+                if (!guard.owns_lock())
+                    Wait(shard, guard);
+                for (auto const& itr : shard.map)
+                    executor(itr.second);
+            }
+        }
+
+        // lock acquisitions which had to wait for another thread since start
+        uint64 GetContentionCount() const
+        {
+            uint64 count = 0;
+            for (Shard const& shard : m_shards)
+                count += shard.contended.load(std::memory_order_relaxed);
+            return count;
+        }
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::shared_mutex lock;
+            std::unordered_map<Key, Value, Hash> map;
+            std::atomic<uint64> contended{0};
+        };
+
+        template <typename Guard>
+        static void Wait(Shard& shard, Guard& guard)
+        {
+            shard.contended.fetch_add(1, std::memory_order_relaxed);
+            guard.lock();
+        }
+
+        Shard& GetShard(Key const& key) const { return m_shards[Hash()(key) % SHARD_COUNT]; }
+
+        mutable std::array<Shard, SHARD_COUNT> m_shards;
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 #include "AsyncSocket.hpp"
+#include "NetworkContextPool.hpp"
 
 namespace MaNGOS
 {
@@ -31,29 +32,80 @@ namespace MaNGOS
     {
         public:
             // constructor for accepting connection from client
-            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
+            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port)), m_pool(nullptr)
             {
                 startAccept();
             }
-            void HandleAccept(std::shared_ptr<SocketType> connection, const boost::system::error_code& err)
+
+            // acceptor of one network context, sharing the port with the acceptors of the other contexts of its pool
+            AsyncListener(NetworkContext& context, std::string const& bindIp, unsigned short port, bool reusePort) : m_context(context.GetContext()), m_acceptor(context.GetContext()),
+                m_statistics(context.GetStatistics()), m_pool(nullptr)
+            {
+                open(boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port), reusePort);
+                startAccept();
+            }
+
+            // single acceptor handing its connections round robin to the contexts of pool
+            AsyncListener(NetworkContextPool& pool, std::string const& bindIp, unsigned short port) : m_context(pool.GetContext(0).GetContext()), m_acceptor(m_context),
+                m_pool(&pool)
+            {
+                open(boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port), false);
+                startAccept();
+            }
+
+            void HandleAccept(std::shared_ptr<SocketType> connection, std::shared_ptr<NetworkStatistics> statistics, const boost::system::error_code& err)
             {
                 if (!err)
-                    connection->Start();
+                {
+                    if (statistics)
+                        ++statistics->accepted;
+
+                    // start the connection on its own context so all of its callbacks stay there
+                    if (m_pool)
+                        boost::asio::post(connection->GetAsioSocket().get_executor(), [connection]() { connection->Start(); });
+                    else
+                        connection->Start();
+                }
 
                 startAccept();
             }
         private:
             boost::asio::io_context& m_context;
             boost::asio::ip::tcp::acceptor m_acceptor;
+            std::shared_ptr<NetworkStatistics> m_statistics;
+            NetworkContextPool* m_pool;
+
+            void open(boost::asio::ip::tcp::endpoint const& endpoint, bool reusePort)
+            {
+                m_acceptor.open(endpoint.protocol());
+                m_acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+                if (reusePort)
+                    m_acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+#endif
+                m_acceptor.bind(endpoint);
+                m_acceptor.listen();
+            }
+
             void startAccept()
             {
+                boost::asio::io_context* context = &m_context;
+                std::shared_ptr<NetworkStatistics> statistics = m_statistics;
+                if (m_pool)
+                {
+                    NetworkContext& next = m_pool->GetNextContext();
+                    context = &next.GetContext();
+                    statistics = next.GetStatistics();
+                }
+
                 // socket
-                std::shared_ptr<SocketType> connection = std::make_shared<SocketType>(m_context);
+                std::shared_ptr<SocketType> connection = std::make_shared<SocketType>(*context);
+                connection->SetStatistics(statistics);
 
                 // asynchronous accept operation and wait for a new connection.
-                m_acceptor.async_accept(connection->GetAsioSocket(), boost::bind(&AsyncListener::HandleAccept, this, connection, boost::asio::placeholders::error));
+                m_acceptor.async_accept(connection->GetAsioSocket(), boost::bind(&AsyncListener::HandleAccept, this, connection, statistics, boost::asio::placeholders::error));
             }
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -24,6 +24,7 @@
 #include <boost/enable_shared_from_this.hpp>
 #include "boost/lexical_cast.hpp"
 #include "Log/Log.h"
+#include "NetworkContextPool.hpp"
 
 namespace MaNGOS
 {
@@ -60,6 +61,9 @@ namespace MaNGOS
 
             std::string const& GetRemoteEndpoint() const { return m_remoteEndpoint; }
             std::string const& GetRemoteAddress() const { return m_address; }
+
+            // counters of the network context the socket is pinned to, set before Start
+            void SetStatistics(std::shared_ptr<NetworkStatistics> statistics) { m_statistics = std::move(statistics); }
         private:
             virtual bool ProcessIncomingData() = 0;
             virtual bool OnOpen() = 0;
@@ -71,11 +75,14 @@ namespace MaNGOS
             std::string m_remoteEndpoint;
             boost::asio::ip::address m_remoteAddress;
             uint16 m_remotePort;
+
+            std::shared_ptr<NetworkStatistics> m_statistics;
+            bool m_started;
     };
 
     template <typename SocketType>
     MaNGOS::AsyncSocket<SocketType>::AsyncSocket(boost::asio::io_context& io_context) : m_socket(io_context), m_address("0.0.0.0"),
-        m_remoteAddress(boost::asio::ip::address()), m_remotePort(0)
+        m_remoteAddress(boost::asio::ip::address()), m_remotePort(0), m_started(false)
     {
 
     }
@@ -84,18 +91,48 @@ namespace MaNGOS
     MaNGOS::AsyncSocket<SocketType>::~AsyncSocket()
     {
         m_socket.close();
+
+        if (m_statistics && m_started)
+            --m_statistics->connections;
     }
 
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::Read(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), callback);
+        if (!m_statistics)
+        {
+            boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), callback);
+            return;
+        }
+
+        // the statistics outlive the handler, the socket holding them is kept alive by the callback
+        NetworkStatistics* statistics = m_statistics.get();
+        ++statistics->pendingOperations;
+        boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), [statistics, callback = std::move(callback)](const boost::system::error_code& error, std::size_t read)
+        {
+            --statistics->pendingOperations;
+            statistics->bytesIn += read;
+            callback(error, read);
+        });
     }
 
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, callback);
+        if (!m_statistics)
+        {
+            boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, callback);
+            return;
+        }
+
+        NetworkStatistics* statistics = m_statistics.get();
+        ++statistics->pendingOperations;
+        boost::asio::async_read_until(m_socket, boost::asio::dynamic_buffer(buffer, 1024), delimiter, [statistics, callback = std::move(callback)](const boost::system::error_code& error, std::size_t read)
+        {
+            --statistics->pendingOperations;
+            statistics->bytesIn += read;
+            callback(error, read);
+        });
     }
 
     template<typename SocketType>
@@ -111,7 +148,20 @@ namespace MaNGOS
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
-        boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), callback);
+        if (!m_statistics)
+        {
+            boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), callback);
+            return;
+        }
+
+        NetworkStatistics* statistics = m_statistics.get();
+        ++statistics->pendingOperations;
+        boost::asio::async_write(m_socket, boost::asio::buffer(buffer, length), [statistics, callback = std::move(callback)](const boost::system::error_code& error, std::size_t written)
+        {
+            --statistics->pendingOperations;
+            statistics->bytesOut += written;
+            callback(error, written);
+        });
     }
 
     template <typename SocketType>
@@ -129,6 +179,12 @@ namespace MaNGOS
             sLog.outError("Socket::Open() failed to get remote address.  Error: %s", error.what());
             return false;
         }
+        if (m_statistics)
+        {
+            ++m_statistics->connections;
+            m_started = true;
+        }
+
         OnOpen();
         ProcessIncomingData();
         return true;
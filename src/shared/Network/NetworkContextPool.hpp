@@ -0,0 +1,145 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_NETWORK_CONTEXT_POOL
+#define MANGOSSERVER_NETWORK_CONTEXT_POOL
+
+#include "Platform/Define.h"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace MaNGOS
+{
+    // counters of one network context, shared by all sockets pinned to it
+    struct NetworkStatistics
+    {
+        std::atomic<uint64> bytesIn{0};
+        std::atomic<uint64> bytesOut{0};
+        std::atomic<uint64> accepted{0};
+        std::atomic<uint32> connections{0};
+        // reads and writes started but not completed yet
+        std::atomic<uint32> pendingOperations{0};
+    };
+
+    // io_context run by a single thread, so the callbacks of sockets pinned to it never run concurrently
+    class NetworkContext
+    {
+        public:
+            NetworkContext() : m_work(boost::asio::make_work_guard(m_context)), m_statistics(std::make_shared<NetworkStatistics>()) {}
+            NetworkContext(NetworkContext const&) = delete;
+            NetworkContext& operator=(NetworkContext const&) = delete;
+
+            ~NetworkContext()
+            {
+                Stop();
+            }
+
+            boost::asio::io_context& GetContext() { return m_context; }
+            std::shared_ptr<NetworkStatistics> const& GetStatistics() const { return m_statistics; }
+
+            void Start()
+            {
+                m_thread = std::thread([this]() { m_context.run(); });
+            }
+
+            void Stop()
+            {
+                m_work.reset();
+                m_context.stop();
+                if (m_thread.joinable())
+                    m_thread.join();
+            }
+
+        private:
+            boost::asio::io_context m_context;
+            boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+            std::shared_ptr<NetworkStatistics> m_statistics;
+            std::thread m_thread;
+    };
+
+    class NetworkContextPool
+    {
+        public:
+            explicit NetworkContextPool(size_t count) : m_next(0)
+            {
+                for (size_t i = 0; i < std::max<size_t>(count, 1); ++i)
+                    m_contexts.emplace_back(std::make_unique<NetworkContext>());
+            }
+
+            ~NetworkContextPool()
+            {
+                Stop();
+            }
+
+            // every context can have its own acceptor on the same port, the kernel then balances the connections
+            static bool CanReusePort()
+            {
+#ifdef SO_REUSEPORT
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            // reactor asio was built with, io_uring has to be selected at build time (USE_IO_URING)
+            static char const* GetBackendName()
+            {
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+                return "io_uring";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+                return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+                return "kqueue";
+#elif defined(BOOST_ASIO_HAS_IOCP)
+                return "iocp";
+#else
+                return "select";
+#endif
+            }
+
+            size_t GetSize() const { return m_contexts.size(); }
+            NetworkContext& GetContext(size_t index) { return *m_contexts[index]; }
+
+            // round robin for connections accepted by a single acceptor
+            NetworkContext& GetNextContext()
+            {
+                return *m_contexts[m_next.fetch_add(1, std::memory_order_relaxed) % m_contexts.size()];
+            }
+
+            void Start()
+            {
+                for (auto& context : m_contexts)
+                    context->Start();
+            }
+
+            void Stop()
+            {
+                for (auto& context : m_contexts)
+                    context->Stop();
+            }
+
+        private:
+            std::vector<std::unique_ptr<NetworkContext>> m_contexts;
+            std::atomic<size_t> m_next;
+    };
+}
+
+#endif
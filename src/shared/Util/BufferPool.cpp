@@ -0,0 +1,187 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Util/BufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    // 64, 128, ... 64k
+    constexpr size_t CLASS_COUNT = 11;
+    // bytes moved between a thread cache and the depot in one go
+    constexpr size_t BATCH_BYTES = 64 * 1024;
+    // batches the depot keeps per class before surplus blocks are freed
+    constexpr size_t DEPOT_BATCHES = 16;
+    // requests counted locally before being published
+    constexpr uint64 REQUEST_FLUSH = 1024;
+
+    static_assert((BufferPool::MIN_CLASS_SIZE << (CLASS_COUNT - 1)) == BufferPool::MAX_CLASS_SIZE, "Size classes do not cover the pooled range");
+
+    size_t GetClassIndex(size_t size)
+    {
+        size_t index = 0;
+        for (size_t classSize = BufferPool::MIN_CLASS_SIZE; classSize < size; classSize <<= 1)
+            ++index;
+        return index;
+    }
+
+    size_t GetClassSize(size_t index)
+    {
+        return BufferPool::MIN_CLASS_SIZE << index;
+    }
+
+    size_t GetBatchCount(size_t index)
+    {
+        return std::max<size_t>(2, BATCH_BYTES / GetClassSize(index));
+    }
+
+    std::atomic<uint64> s_requests(0);
+    std::atomic<uint64> s_upstreamAllocations(0);
+
+    struct Depot
+    {
+        std::mutex mutex;
+        std::vector<void*> blocks[CLASS_COUNT];
+    };
+
+    // intentionally never destroyed, buffers owned by other static objects may be released after it would be
+    Depot& GetDepot()
+    {
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    void ReturnToDepot(size_t index, std::vector<void*>& blocks, size_t count)
+    {
+        Depot& depot = GetDepot();
+        size_t const depotLimit = GetBatchCount(index) * DEPOT_BATCHES;
+        auto first = blocks.end() - count;
+        {
+            std::lock_guard<std::mutex> guard(depot.mutex);
+            std::vector<void*>& depotBlocks = depot.blocks[index];
+            size_t const kept = std::min(count, depotLimit - std::min(depotLimit, depotBlocks.size()));
+            depotBlocks.insert(depotBlocks.end(), first, first + kept);
+            first += kept;
+        }
+
+        for (auto itr = first; itr != blocks.end(); ++itr)
+            ::operator delete(*itr);
+
+        blocks.resize(blocks.size() - count);
+    }
+
+    thread_local bool t_cacheDestroyed = false;
+
+    struct ThreadCache
+    {
+        std::vector<void*> blocks[CLASS_COUNT];
+        uint64 requests = 0;
+
+        ~ThreadCache()
+        {
+            s_requests.fetch_add(requests, std::memory_order_relaxed);
+            for (size_t i = 0; i < CLASS_COUNT; ++i)
+                ReturnToDepot(i, blocks[i], blocks[i].size());
+            t_cacheDestroyed = true;
+        }
+    };
+
+    thread_local ThreadCache t_cache;
+}
+
+void* BufferPool::Allocate(size_t size)
+{
+    if (size > MAX_CLASS_SIZE || t_cacheDestroyed)
+    {
+        s_requests.fetch_add(1, std::memory_order_relaxed);
+        s_upstreamAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    ThreadCache& cache = t_cache;
+    if (++cache.requests >= REQUEST_FLUSH)
+    {
+        s_requests.fetch_add(cache.requests, std::memory_order_relaxed);
+        cache.requests = 0;
+    }
+
+    size_t const index = GetClassIndex(size);
+    std::vector<void*>& blocks = cache.blocks[index];
+    if (blocks.empty())
+    {
+        Depot& depot = GetDepot();
+        std::lock_guard<std::mutex> guard(depot.mutex);
+        std::vector<void*>& depotBlocks = depot.blocks[index];
+        size_t const count = std::min(GetBatchCount(index), depotBlocks.size());
+        blocks.insert(blocks.end(), depotBlocks.end() - count, depotBlocks.end());
+        depotBlocks.resize(depotBlocks.size() - count);
+    }
+
+    if (blocks.empty())
+    {
+        s_upstreamAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(GetClassSize(index));
+    }
+
+    void* block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+
+void BufferPool::Deallocate(void* block, size_t size)
+{
+    if (!block)
+        return;
+
+    if (size > MAX_CLASS_SIZE || t_cacheDestroyed)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    size_t const index = GetClassIndex(size);
+    std::vector<void*>& blocks = t_cache.blocks[index];
+    blocks.push_back(block);
+
+    // keep one batch around for this thread, hand the other one to threads that allocate more than they free
+    size_t const batch = GetBatchCount(index);
+    if (blocks.size() >= batch * 2)
+        ReturnToDepot(index, blocks, batch);
+}
+
+size_t BufferPool::GetBlockSize(size_t size)
+{
+    if (size > MAX_CLASS_SIZE)
+        return size;
+
+    return GetClassSize(GetClassIndex(size));
+}
+
+uint64 BufferPool::GetRequestCount()
+{
+    return s_requests.load(std::memory_order_relaxed);
+}
+
+uint64 BufferPool::GetUpstreamAllocationCount()
+{
+    return s_upstreamAllocations.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _BUFFERPOOL_H
+#define _BUFFERPOOL_H
+
+#include "Platform/Define.h"
+#include <cstddef>
+#include <new>
+
+// Size class pool for packet and byte buffers
+// Every thread keeps a small cache per size class, surplus blocks are exchanged in batches through a shared depot
+// so buffers built on one thread and released on another (map thread -> network thread) still get reused
+namespace BufferPool
+{
+    // smallest and biggest pooled block, anything bigger goes straight to the allocator
+    static constexpr size_t MIN_CLASS_SIZE = 64;
+    static constexpr size_t MAX_CLASS_SIZE = 64 * 1024;
+
+    void* Allocate(size_t size);
+    void Deallocate(void* block, size_t size);
+
+    // usable size of the block returned for a request of size bytes
+    size_t GetBlockSize(size_t size);
+
+    // total number of Allocate calls and how many of them had to reach the system allocator
+    uint64 GetRequestCount();
+    uint64 GetUpstreamAllocationCount();
+}
+
+template <typename T>
+class PooledAllocator
+{
+    public:
+        typedef T value_type;
+
+        PooledAllocator() noexcept = default;
+        template <typename U> PooledAllocator(PooledAllocator<U> const&) noexcept {}
+
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(BufferPool::Allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T* block, size_t count) noexcept
+        {
+            BufferPool::Deallocate(block, count * sizeof(T));
+        }
+
+        template <typename U> bool operator==(PooledAllocator<U> const&) const noexcept { return true; }
+        template <typename U> bool operator!=(PooledAllocator<U> const&) const noexcept { return false; }
+};
+
+#endif
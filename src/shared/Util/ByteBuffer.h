@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "Util/ByteConverter.h"
+#include "Util/BufferPool.h"
 #include <utf8.h>
 
 class ByteBufferException
@@ -52,7 +53,7 @@ class ByteBuffer
 
         explicit ByteBuffer(size_t reservedSize = s_defaultSize): _rpos(0), _wpos(0)
         {
-            _storage.reserve(reservedSize);
+            reserveBlock(reservedSize);
         }
 
         virtual ~ByteBuffer() = default;
@@ -72,7 +73,7 @@ class ByteBuffer
 
         ByteBuffer(size_t size, Reserve) : _rpos(0), _wpos(0)
         {
-            _storage.reserve(size);
+            reserveBlock(size);
         }
 
         ByteBuffer(size_t size, Resize) : _rpos(0), _wpos(size)
@@ -361,6 +362,7 @@ class ByteBuffer
         }
 
         const uint8* contents() const { return &_storage[0]; }
+        uint8* contents() { return _storage.data(); }
 
         size_t size() const { return _storage.size(); }
         bool empty() const { return _storage.empty(); }
@@ -375,7 +377,7 @@ class ByteBuffer
         void reserve(size_t ressize)
         {
             if (ressize > size())
-                _storage.reserve(ressize);
+                reserveBlock(ressize);
         }
 
         void append(const std::string& str)
@@ -401,7 +403,12 @@ class ByteBuffer
             MANGOS_ASSERT(size() < 10000000);
 
             if (_storage.size() < _wpos + cnt)
+            {
+                // grow straight to the full pool block instead of letting the vector reallocate inside it
+                if (_storage.capacity() < _wpos + cnt)
+                    reserveBlock(std::max(_wpos + cnt, _storage.capacity() * 2));
                 _storage.resize(_wpos + cnt);
+            }
             memcpy(&_storage[_wpos], src, cnt);
             _wpos += cnt;
         }
@@ -459,6 +466,13 @@ class ByteBuffer
         void hexlike() const;
 
     private:
+        // pooled blocks come in size classes, reserving the whole block saves reallocations within it
+        void reserveBlock(size_t ressize)
+        {
+            if (ressize)
+                _storage.reserve(BufferPool::GetBlockSize(ressize));
+        }
+
         // limited for internal use because can "append" any unexpected type (like pointer and etc) with hard detection problem
         template <typename T> void append(T value)
         {
@@ -467,7 +481,7 @@ class ByteBuffer
         }
 
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        std::vector<uint8, PooledAllocator<uint8>> _storage;
 
         static constexpr size_t s_defaultSize = 0x1000;
 };
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MPSCQ_H
+#define _MPSCQ_H
+
+#include <atomic>
+
+// Unbounded intrusive multiple producer single consumer queue, the queue never allocates
+// T links through a std::atomic<T*> m_queueNext member and must be default constructible for the stub node
+// Enqueue never blocks and may be called from any thread, Dequeue must only be called by one thread at a time
+template <typename T>
+class MPSCQueue
+{
+    public:
+        MPSCQueue() : m_head(&m_stub), m_tail(&m_stub) { m_stub.m_queueNext.store(nullptr, std::memory_order_relaxed); }
+        MPSCQueue(const MPSCQueue<T>&) = delete;
+
+        // the queue does not own the nodes, the owner drains it before destruction
+        ~MPSCQueue() {}
+
+        void Enqueue(T* node)
+        {
+            node->m_queueNext.store(nullptr, std::memory_order_relaxed);
+            T* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->m_queueNext.store(node, std::memory_order_release);
+        }
+
+        // nullptr when empty or when the next node is still being linked by its producer, which then flushes again
+        T* Dequeue()
+        {
+            T* tail = m_tail;
+            T* next = tail->m_queueNext.load(std::memory_order_acquire);
+            if (tail == &m_stub)
+            {
+                if (!next)
+                    return nullptr;
+
+                m_tail = next;
+                tail = next;
+                next = next->m_queueNext.load(std::memory_order_acquire);
+            }
+
+            if (next)
+            {
+                m_tail = next;
+                return tail;
+            }
+
+            // tail is the last linked node, it can only be handed out once the stub is queued behind it
+            if (tail != m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            Enqueue(&m_stub);
+            next = tail->m_queueNext.load(std::memory_order_acquire);
+            if (!next)
+                return nullptr;
+
+            m_tail = next;
+            return tail;
+        }
+
+    private:
+        std::atomic<T*> m_head;                             // last enqueued node
+        T* m_tail;                                          // next node to hand out, or the stub
+        T m_stub;
+};
+
+#endif
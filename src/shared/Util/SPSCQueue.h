@@ -0,0 +1,112 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _SPSCQ_H
+#define _SPSCQ_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded single producer single consumer ring
+// TryEnqueue must only be called by one thread at a time and Dequeue by one other thread at a time
+template <typename T>
+class SPSCQueue
+{
+    public:
+        // capacity is rounded up to a power of two
+        explicit SPSCQueue(size_t capacity) : m_mask(RoundUp(capacity) - 1), m_buffer(new T[m_mask + 1]), m_head(0), m_tailCache(0), m_tail(0), m_headCache(0) { }
+        SPSCQueue(const SPSCQueue<T>&) = delete;
+
+        // value is left untouched when the ring is full
+        bool TryEnqueue(T&& value)
+        {
+            size_t const head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tailCache > m_mask)
+            {
+                m_tailCache = m_tail.load(std::memory_order_acquire);
+                if (head - m_tailCache > m_mask)
+                    return false;
+            }
+
+            m_buffer[head & m_mask] = std::move(value);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Dequeue(T& value)
+        {
+            size_t const tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_headCache)
+            {
+                m_headCache = m_head.load(std::memory_order_acquire);
+                if (tail == m_headCache)
+                    return false;
+            }
+
+            value = std::move(m_buffer[tail & m_mask]);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer side peek, the element stays in the ring until the next Dequeue
+        T* Front()
+        {
+            size_t const tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_headCache)
+            {
+                m_headCache = m_head.load(std::memory_order_acquire);
+                if (tail == m_headCache)
+                    return nullptr;
+            }
+
+            return &m_buffer[tail & m_mask];
+        }
+
+        // exact only when called from the producer or consumer, a snapshot otherwise
+        size_t Size() const
+        {
+            size_t const tail = m_tail.load(std::memory_order_acquire);
+            return m_head.load(std::memory_order_acquire) - tail;
+        }
+
+        size_t Capacity() const { return m_mask + 1; }
+
+    private:
+        static size_t RoundUp(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+            return size;
+        }
+
+        size_t const m_mask;
+        std::unique_ptr<T[]> m_buffer;
+
+        // producer side
+        alignas(64) std::atomic<size_t> m_head;
+        size_t m_tailCache;
+
+        // consumer side
+        alignas(64) std::atomic<size_t> m_tail;
+        size_t m_headCache;
+};
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _STABLEVECTOR_H
+#define _STABLEVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// Contiguous list of pointers that, like a linked list, may be added to and removed from while being iterated
+// Iterators hold an index, so growing the storage does not invalidate them, and removed entries are only
+// marked and skipped until the owner calls Compact() at a point where nothing iterates the list.
+// Dereferencing an iterator whose entry was removed meanwhile still yields the removed pointer.
+template <typename T>
+class StableVector
+{
+        static_assert(std::is_pointer<T>::value, "StableVector only holds pointers");
+
+    public:
+        class const_iterator
+        {
+            public:
+                typedef std::bidirectional_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef T const* pointer;
+                typedef T reference;
+
+                const_iterator() : m_vector(nullptr), m_index(END) {}
+                const_iterator(StableVector const* vector, size_t index) : m_vector(vector), m_index(index) {}
+
+                T operator*() const { return Untag(m_vector->m_items[m_index]); }
+
+                const_iterator& operator++()
+                {
+                    ++m_index;
+                    Skip();
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator itr = *this;
+                    ++*this;
+                    return itr;
+                }
+
+                const_iterator& operator--()
+                {
+                    if (m_index > m_vector->m_items.size())
+                        m_index = m_vector->m_items.size();
+
+                    do
+                        --m_index;
+                    while (IsRemoved(m_vector->m_items[m_index]));
+                    return *this;
+                }
+
+                const_iterator operator--(int)
+                {
+                    const_iterator itr = *this;
+                    --*this;
+                    return itr;
+                }
+
+                // entries removed since the iterator was positioned are skipped here, before the caller dereferences
+                bool operator==(const_iterator const& other) const
+                {
+                    Skip();
+                    other.Skip();
+                    return m_index == other.m_index;
+                }
+
+                bool operator!=(const_iterator const& other) const { return !(*this == other); }
+
+            private:
+                friend class StableVector;
+
+                void Skip() const
+                {
+                    if (!m_vector)
+                        return;
+
+                    std::vector<T> const& items = m_vector->m_items;
+                    while (m_index < items.size() && IsRemoved(items[m_index]))
+                        ++m_index;
+
+                    if (m_index >= items.size())
+                        m_index = END;
+                }
+
+                StableVector const* m_vector;
+                mutable size_t m_index;
+        };
+
+        typedef const_iterator iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef const_reverse_iterator reverse_iterator;
+        typedef T value_type;
+
+        StableVector() : m_count(0), m_holes(false) {}
+
+        const_iterator begin() const
+        {
+            const_iterator itr(this, 0);
+            itr.Skip();
+            return itr;
+        }
+
+        const_iterator end() const { return const_iterator(this, END); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        T front() const { return *begin(); }
+        T back() const { return *--end(); }
+
+        size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+
+        void push_back(T value)
+        {
+            m_items.push_back(value);
+            ++m_count;
+        }
+
+        // same as std::list::remove, every entry equal to value is removed
+        void remove(T value)
+        {
+            for (T& item : m_items)
+                if (item == value)
+                    Remove(item);
+        }
+
+        const_iterator erase(const_iterator itr)
+        {
+            itr.Skip();
+            Remove(m_items[itr.m_index]);
+            return ++itr;
+        }
+
+        void clear()
+        {
+            m_items.clear();
+            m_count = 0;
+            m_holes = false;
+        }
+
+        // true once an entry was removed since the last Compact()
+        bool HasHoles() const { return m_holes; }
+
+        // drops the removed entries, no iterator of this list may be in use
+        void Compact()
+        {
+            if (!m_holes)
+                return;
+
+            size_t kept = 0;
+            for (T item : m_items)
+                if (!IsRemoved(item))
+                    m_items[kept++] = item;
+
+            m_items.resize(kept);
+            m_holes = false;
+        }
+
+    private:
+        static constexpr size_t END = std::numeric_limits<size_t>::max();
+
+        static bool IsRemoved(T item) { return reinterpret_cast<uintptr_t>(item) & 1; }
+        static T Untag(T item) { return reinterpret_cast<T>(reinterpret_cast<uintptr_t>(item) & ~uintptr_t(1)); }
+
+        void Remove(T& item)
+        {
+            item = reinterpret_cast<T>(reinterpret_cast<uintptr_t>(item) | 1);
+            --m_count;
+            m_holes = true;
+        }
+
+        std::vector<T> m_items;
+        size_t m_count;
+        bool m_holes;
+};
+
+#endif